@@ -0,0 +1,50 @@
+#!/usr/bin/env ruby
+
+require 'rubygems'
+require 'rubyfb'
+require 'bigdecimal'
+require 'benchmark'
+
+include Rubyfb
+
+# Compares the DECIMAL_MODE settings for reading, and Float, String and
+# BigDecimal values for binding, on a NUMERIC(18,4) column.
+
+# Database details constants.
+DB_FILE      = "localhost:#{File.expand_path('.')}#{File::SEPARATOR}decimal.fdb"
+DB_USER_NAME = "sysdba"
+DB_PASSWORD  = "masterkey"
+ROWS         = 100000
+
+db = Database.create(DB_FILE, DB_USER_NAME, DB_PASSWORD, 4096)
+begin
+   db.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate('CREATE TABLE AMOUNTS (AMOUNT NUMERIC(18,4))')
+
+      Benchmark.bm(20) do |bm|
+         {'bind Float'      => 1234.5678,
+          'bind String'     => '1234.5678',
+          'bind BigDecimal' => BigDecimal('1234.5678')}.each do |label, value|
+            bm.report(label) do
+               cxn.start_transaction do |tx|
+                  stmt = cxn.create_statement('INSERT INTO AMOUNTS VALUES (?)')
+                  ROWS.times {stmt.exec([value], tx)}
+                  stmt.close
+               end
+            end
+         end
+
+         [:float, :big_decimal, :rational, :integer].each do |mode|
+            $FireRubySettings[:DECIMAL_MODE] = mode
+            bm.report("read #{mode}") do
+               cxn.start_transaction do |tx|
+                  cxn.execute('SELECT AMOUNT FROM AMOUNTS', tx) {|row| row[0]}
+               end
+            end
+         end
+         $FireRubySettings[:DECIMAL_MODE] = :float
+      end
+   end
+ensure
+   db.drop(DB_USER_NAME, DB_PASSWORD)
+end
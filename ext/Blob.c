@@ -28,14 +28,42 @@
 #include <limits.h>
 #include "Common.h"
 #include "rfbstr.h"
+#include "rfbgvl.h"
 
 /* Function prototypes. */
 static VALUE allocateBlob(VALUE);
 static VALUE getBlobData(VALUE);
 static VALUE closeBlob(VALUE);
-static VALUE eachBlobSegment(VALUE);
-char *loadBlobData(BlobHandle *);
-char *loadBlobSegment(BlobHandle *, unsigned short *);
+static VALUE eachBlobSegment(int, VALUE *, VALUE);
+static VALUE readBlob(int, VALUE *, VALUE);
+static VALUE readPartialBlob(int, VALUE *, VALUE);
+static VALUE getBlobEOF(VALUE);
+static VALUE getBlobSize(VALUE);
+static void prepareBlob(VALUE, BlobHandle *);
+static long readBlobString(BlobHandle *, VALUE, long, short, isc_db_handle *);
+static VALUE loadInlineBlob(VALUE);
+static VALUE releaseInlineBlob(VALUE);
+static VALUE readBlobSegments(VALUE);
+static VALUE finishBlobRead(VALUE);
+
+/* Type definitions. */
+typedef struct {
+  BlobHandle    *blob;
+  isc_db_handle *connection;
+  VALUE         buffer;
+  long          length,
+                offset;
+  short         partial;
+} BlobReader;
+
+typedef struct {
+  BlobHandle *blob;
+  VALUE      connection,
+             transaction,
+             data;
+  long       limit;
+  short      done;
+} InlineBlob;
 
 /* Globals. */
 VALUE cBlob;
@@ -54,8 +82,11 @@ static VALUE allocateBlob(VALUE klass) {
 
   if(blob != NULL) {
     memset(&blob->description, 0, sizeof(ISC_BLOB_DESC));
-    blob->segments = blob->size = 0;
+    memset(&blob->id, 0, sizeof(ISC_QUAD));
+    blob->segments = blob->size = blob->maximum = blob->position = 0;
     blob->handle   = 0;
+    blob->eof      = 0;
+    blob->deferred = 0;
     instance       = Data_Wrap_Struct(klass, NULL, blobFree, blob);
   } else {
     rb_raise(rb_eNoMemError, "Memory allocation failure allocating a blob.");
@@ -87,7 +118,9 @@ VALUE initializeBlob(VALUE self, VALUE connection) {
  *
  * @param  self  A reference to the Blob object to fetch the data for.
  *
- * @return  A reference to a String containing the Blob object data.
+ * @return  A reference to a String containing the Blob object data. An error
+ *          is raised if some of the data has already been read by the read,
+ *          readpartial or each methods.
  *
  */
 static VALUE getBlobData(VALUE self) {
@@ -95,16 +128,25 @@ static VALUE getBlobData(VALUE self) {
   VALUE connection = rb_iv_get(self, "@connection");
 
   if(data == Qnil) {
-    BlobHandle *blob   = NULL;
+    BlobHandle       *blob   = NULL;
+    ConnectionHandle *hConnection = NULL;
 
     Data_Get_Struct(self, BlobHandle, blob);
+    prepareBlob(self, blob);
+    Data_Get_Struct(connection, ConnectionHandle, hConnection);
+    if(blob->position > 0) {
+      rb_fireruby_raise(NULL, "Blob data has already been partly read.");
+    }
     if(blob->size > 0) {
-      char *buffer = loadBlobData(blob);
-      if(buffer != NULL) {
-        data = rfbstr(connection, blob->charset, buffer, blob->size);
-        free(buffer);
-        rb_iv_set(self, "@data", data);
+      if(blob->handle == 0) {
+        rb_fireruby_raise(NULL, "Invalid blob specified for loading.");
       }
+      /* Read the data straight into the String that is returned. */
+      data = rb_str_new(NULL, blob->size);
+      rb_str_set_len(data, readBlobString(blob, data, RSTRING_LEN(data), 0,
+                                          &hConnection->handle));
+      rfbsetencoding(data, blob->encoding);
+      rb_iv_set(self, "@data", data);
     }
   }
 
@@ -112,6 +154,311 @@ static VALUE getBlobData(VALUE self) {
 }
 
 
+/**
+ * This function reads blob data into a Ruby String in place, replacing the
+ * String contents. The lock on the client library is released while each
+ * segment is read.
+ *
+ * @param  blob        A pointer to the BlobHandle for the blob.
+ * @param  buffer      A reference to the String to read the data into.
+ * @param  length      The maximum number of bytes to be read.
+ * @param  partial     1 to return as soon as some data has been read, 0 to
+ *                     read until length bytes have been read or the end of
+ *                     the blob is reached.
+ * @param  connection  A pointer to the database handle the blob was opened on.
+ *
+ * @return  The number of bytes read, 0 at the end of the blob.
+ *
+ */
+static long readBlobString(BlobHandle *blob, VALUE buffer, long length,
+                           short partial, isc_db_handle *connection) {
+  BlobReader reader;
+
+  reader.blob       = blob;
+  reader.connection = connection;
+  reader.buffer     = buffer;
+  reader.length     = length;
+  reader.offset     = 0;
+  reader.partial    = partial;
+
+  rb_str_modify(buffer);
+  rb_str_resize(buffer, length);
+
+  /* The string must not change while the lock is released, and the read is
+     finished off however it ends. */
+  rb_str_locktmp(buffer);
+  rb_ensure(readBlobSegments, (VALUE)&reader, finishBlobRead, (VALUE)&reader);
+
+  return(reader.offset);
+}
+
+
+/**
+ * This function reads blob segments into the String of a BlobReader, for
+ * readBlobString.
+ *
+ * @param  data  A pointer to the BlobReader for the read, cast to a VALUE.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE readBlobSegments(VALUE data) {
+  BlobReader *reader = (BlobReader *)data;
+
+  while(reader->offset < reader->length && !reader->blob->eof) {
+    ISC_STATUS     status[ISC_STATUS_LENGTH],
+                   result;
+    unsigned short quantity  = 0,
+                   available = (reader->length - reader->offset) > USHRT_MAX ?
+                               USHRT_MAX : reader->length - reader->offset;
+
+    result = rfb_get_segment(status, &reader->blob->handle, &quantity,
+                             available,
+                             &RSTRING_PTR(reader->buffer)[reader->offset],
+                             reader->connection);
+    reader->offset = reader->offset + quantity;
+    if(result == isc_segstr_eof) {
+      reader->blob->eof = 1;
+    } else if(result != 0 && result != isc_segment) {
+      rb_fireruby_raise(status, "Error loading blob data.");
+    }
+    if(reader->partial && reader->offset > 0) {
+      break;
+    }
+    rb_thread_check_ints();
+  }
+
+  return(Qnil);
+}
+
+
+/**
+ * This function unlocks the String of a BlobReader, trims it to the data
+ * read and counts that data against the blob position, for readBlobString.
+ *
+ * @param  data  A pointer to the BlobReader for the read, cast to a VALUE.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE finishBlobRead(VALUE data) {
+  BlobReader *reader = (BlobReader *)data;
+
+  rb_str_unlocktmp(reader->buffer);
+  rb_str_set_len(reader->buffer, reader->offset);
+  reader->blob->position += reader->offset;
+
+  return(Qnil);
+}
+
+
+/**
+ * This function opens a newly created blob and, if it is no larger than a
+ * given size, reads the entire contents into a String to be returned in place
+ * of a Blob object. An inlined blob is closed and released, as is the blob if
+ * an error occurs.
+ *
+ * @param  blob         A pointer to the BlobHandle created for the blob.
+ * @param  limit        The size in bytes up to which the blob is inlined.
+ * @param  connection   A reference to the Connection for the blob.
+ * @param  transaction  A reference to the Transaction for the blob.
+ *
+ * @return  A reference to a String containing the blob data in the blob
+ *          character set, or nil if the blob is too large to be inlined in
+ *          which case the blob is left open.
+ *
+ */
+VALUE inlineBlob(BlobHandle *blob, long limit, VALUE connection,
+                 VALUE transaction) {
+  InlineBlob inlined;
+
+  inlined.blob        = blob;
+  inlined.limit       = limit;
+  inlined.data        = Qnil;
+  inlined.connection  = connection;
+  inlined.transaction = transaction;
+  inlined.done        = 0;
+  rb_ensure(loadInlineBlob, (VALUE)&inlined,
+            releaseInlineBlob, (VALUE)&inlined);
+
+  return(inlined.data);
+}
+
+
+/**
+ * This function performs the open and read for the inlineBlob function.
+ *
+ * @param  data  A pointer to the InlineBlob structure for the read.
+ *
+ * @return  A reference to the String read, or nil if the blob is too large.
+ *
+ */
+static VALUE loadInlineBlob(VALUE data) {
+  InlineBlob       *inlined = (InlineBlob *)data;
+  BlobHandle       *blob    = inlined->blob;
+  ConnectionHandle *hConnection = NULL;
+
+  Data_Get_Struct(inlined->connection, ConnectionHandle, hConnection);
+  openBlob(blob, inlined->connection, inlined->transaction);
+  if(blob->size <= inlined->limit) {
+    inlined->data = rb_str_new(NULL, blob->size);
+    rb_str_set_len(inlined->data,
+                   readBlobString(blob, inlined->data, blob->size, 0,
+                                  &hConnection->handle));
+    rfbsetencoding(inlined->data, blob->encoding);
+  }
+  inlined->done = 1;
+  return(inlined->data);
+}
+
+
+/**
+ * This function closes and releases the blob for the inlineBlob function,
+ * unless it has been opened to be returned as a Blob object.
+ *
+ * @param  data  A pointer to the InlineBlob structure for the read.
+ *
+ * @return  Always Qnil.
+ *
+ */
+static VALUE releaseInlineBlob(VALUE data) {
+  InlineBlob *inlined = (InlineBlob *)data;
+
+  if(!inlined->done || inlined->data != Qnil) {
+    blobFree(inlined->blob);
+  }
+  return(Qnil);
+}
+
+
+/**
+ * This function provides the read method for the Blob class, modelled on the
+ * IO#read method.
+ *
+ * @param  argc  A count of the arguments passed to the method.
+ * @param  argv  A pointer to the arguments passed to the method, an optional
+ *               length and an optional String to read the data into.
+ * @param  self  A reference to the Blob object to call the method on.
+ *
+ * @return  A reference to a String containing up to length bytes of binary
+ *          data, or the remaining blob data if no length is given. nil is
+ *          returned if a length is given and the end of the blob has been
+ *          reached.
+ *
+ */
+static VALUE readBlob(int argc, VALUE *argv, VALUE self) {
+  VALUE            length = Qnil,
+                   buffer = Qnil,
+                   connection = rb_iv_get(self, "@connection");
+  BlobHandle       *blob = NULL;
+  ConnectionHandle *hConnection = NULL;
+  long             limit, count;
+
+  rb_scan_args(argc, argv, "02", &length, &buffer);
+  Data_Get_Struct(self, BlobHandle, blob);
+  prepareBlob(self, blob);
+  Data_Get_Struct(connection, ConnectionHandle, hConnection);
+  if(blob->handle == 0) {
+    rb_fireruby_raise(NULL, "Invalid blob specified for loading.");
+  }
+  if(length == Qnil) {
+    limit = blob->size > blob->position ? blob->size - blob->position : 0;
+  } else if((limit = NUM2LONG(length)) < 0) {
+    rb_raise(rb_eArgError, "Negative length (%ld) specified for read.", limit);
+  }
+  buffer = (buffer == Qnil ? rb_str_new(NULL, 0) : StringValue(buffer));
+
+  count = readBlobString(blob, buffer, limit, 0, &hConnection->handle);
+  rb_str_set_len(buffer, count);
+  if(length == Qnil) {
+    return(rfbsetencoding(buffer, blob->encoding));
+  }
+  rfbsetencoding(buffer, rfbencoding(Qnil));
+
+  return(count == 0 && limit > 0 ? Qnil : buffer);
+}
+
+
+/**
+ * This function provides the readpartial method for the Blob class, modelled
+ * on the IO#readpartial method, allowing a Blob to be used as the source for
+ * IO.copy_stream.
+ *
+ * @param  argc  A count of the arguments passed to the method.
+ * @param  argv  A pointer to the arguments passed to the method, a maximum
+ *               length and an optional String to read the data into.
+ * @param  self  A reference to the Blob object to call the method on.
+ *
+ * @return  A reference to a String containing up to length bytes of binary
+ *          data. An EOFError is raised at the end of the blob.
+ *
+ */
+static VALUE readPartialBlob(int argc, VALUE *argv, VALUE self) {
+  VALUE            length, buffer = Qnil,
+                   connection = rb_iv_get(self, "@connection");
+  BlobHandle       *blob = NULL;
+  ConnectionHandle *hConnection = NULL;
+  long             limit, count;
+
+  rb_scan_args(argc, argv, "11", &length, &buffer);
+  Data_Get_Struct(self, BlobHandle, blob);
+  prepareBlob(self, blob);
+  Data_Get_Struct(connection, ConnectionHandle, hConnection);
+  if(blob->handle == 0) {
+    rb_fireruby_raise(NULL, "Invalid blob specified for loading.");
+  }
+  if((limit = NUM2LONG(length)) < 0) {
+    rb_raise(rb_eArgError, "Negative length (%ld) specified for read.", limit);
+  }
+  buffer = (buffer == Qnil ? rb_str_new(NULL, 0) : StringValue(buffer));
+
+  count = readBlobString(blob, buffer, limit, 1, &hConnection->handle);
+  rb_str_set_len(buffer, count);
+  rfbsetencoding(buffer, rfbencoding(Qnil));
+  if(count == 0 && limit > 0) {
+    rb_raise(rb_eEOFError, "End of blob reached.");
+  }
+
+  return(buffer);
+}
+
+
+/**
+ * This function provides the eof? method for the Blob class.
+ *
+ * @param  self  A reference to the Blob object to call the method on.
+ *
+ * @return  Qtrue if all of the blob data has been read, Qfalse otherwise.
+ *
+ */
+static VALUE getBlobEOF(VALUE self) {
+  BlobHandle *blob = NULL;
+
+  Data_Get_Struct(self, BlobHandle, blob);
+  prepareBlob(self, blob);
+
+  return(blob->eof || blob->position >= blob->size ? Qtrue : Qfalse);
+}
+
+
+/**
+ * This function provides the size method for the Blob class.
+ *
+ * @param  self  A reference to the Blob object to call the method on.
+ *
+ * @return  The total length of the blob data in bytes.
+ *
+ */
+static VALUE getBlobSize(VALUE self) {
+  BlobHandle *blob = NULL;
+
+  Data_Get_Struct(self, BlobHandle, blob);
+  prepareBlob(self, blob);
+
+  return(LONG2NUM(blob->size));
+}
+
+
 /**
  * This function provides the close method for the Blob class, allowing the
  * resources for a blob to be explicitly released. It is not valid to use a
@@ -131,6 +478,7 @@ static VALUE closeBlob(VALUE self) {
   }
 
   Data_Get_Struct(self, BlobHandle, blob);
+  blob->deferred = 0;
   if(blob->handle != 0) {
     ISC_STATUS status[ISC_STATUS_LENGTH];
 
@@ -146,28 +494,60 @@ static VALUE closeBlob(VALUE self) {
 
 /**
  * This function provides the each method for the Blob class. This function
- * feeds a segment of a blob to a block.
+ * feeds a segment of a blob to a block. Each segment is read directly into
+ * the String yielded with the lock on the client library released.
  *
+ * @param  argc  A count of the arguments passed to the method.
+ * @param  argv  A pointer to the arguments passed to the method, an optional
+ *               maximum segment size and an optional String that will be
+ *               reused for each of the segments yielded.
  * @param  self  A reference to the Blob object to make the call for.
  *
  * @return  A reference to the last return value from the block called.
  *
  */
-static VALUE eachBlobSegment(VALUE self) {
+static VALUE eachBlobSegment(int argc, VALUE *argv, VALUE self) {
   VALUE result = Qnil;
 
   if(rb_block_given_p()) {
-    VALUE connection = rb_iv_get(self, "@connection");
-    BlobHandle     *blob    = NULL;
-    char           *segment = NULL;
-    unsigned short size     = 0;
-
+    VALUE connection = rb_iv_get(self, "@connection"),
+          length     = Qnil,
+          buffer     = Qnil,
+          segment    = Qnil;
+    BlobHandle       *blob    = NULL;
+    ConnectionHandle *hConnection = NULL;
+    long             size     = 0,
+                     count    = 0;
+
+    rb_scan_args(argc, argv, "02", &length, &buffer);
     Data_Get_Struct(self, BlobHandle, blob);
-    segment = loadBlobSegment(blob, &size);
-    while(segment != NULL) {
-      result = rb_yield(rb_str_new(segment, size));
-      free(segment);
-      segment = loadBlobSegment(blob, &size);
+    prepareBlob(self, blob);
+    Data_Get_Struct(connection, ConnectionHandle, hConnection);
+    if(blob->handle == 0) {
+      rb_fireruby_raise(NULL, "Invalid blob specified for loading.");
+    }
+    if(length != Qnil) {
+      size = NUM2LONG(length);
+    } else if((size = blob->maximum) == 0) {
+      size = blob->description.blob_desc_segment_size;
+    }
+    if(size <= 0 || size > USHRT_MAX) {
+      size = USHRT_MAX;
+    }
+    if(buffer != Qnil) {
+      buffer = StringValue(buffer);
+    }
+
+    segment = (buffer == Qnil ? rb_str_new(NULL, 0) : buffer);
+    while((count = readBlobString(blob, segment, size, 1,
+                                  &hConnection->handle)) > 0) {
+      if(buffer == Qnil) {
+        rb_str_resize(segment, count);
+      } else {
+        rb_str_set_len(segment, count);
+      }
+      result  = rb_yield(rfbsetencoding(segment, rfbencoding(Qnil)));
+      segment = (buffer == Qnil ? rb_str_new(NULL, 0) : buffer);
     }
   }
 
@@ -176,75 +556,37 @@ static VALUE eachBlobSegment(VALUE self) {
 
 
 /**
- * This function allocates a BlobHandle structure and opens the structure for
- * use.
+ * This function allocates a BlobHandle structure for a blob fetched from the
+ * database. Only the blob id is kept, the blob is not opened until the data
+ * or details of the blob are first needed.
  *
  * @param  blobEntry    The blob SQLVAR data.
- * @param  table        The name of the table containing the blob being opened.
+ * @param  table        The name of the table containing the blob.
  * @param  column       The name of the column in the table that contains the
  *                      blob.
- * @param  connection   The connection to be used in accessing the blob.
- * @param  transaction  The transaction to be used in accessing the blob.
+ * @param  encoding     The index of the Ruby encoding for the blob data.
  *
- * @return  A pointer to an allocated and opened BlobHandle structure.
+ * @return  A pointer to an allocated, unopened BlobHandle structure.
  *
  */
-BlobHandle *openBlob(XSQLVAR *blobEntry,
-                     char *table,
-                     char *column,
-                     VALUE connection,
-                     VALUE transaction) {
-  ConnectionHandle  *cHandle    = NULL;
-  TransactionHandle *tHandle    = NULL;
-  Data_Get_Struct(connection, ConnectionHandle, cHandle);
-  Data_Get_Struct(transaction, TransactionHandle, tHandle);
-  ISC_QUAD blobId = *(ISC_QUAD *)blobEntry->sqldata;
-                     
+BlobHandle *createBlob(XSQLVAR *blobEntry,
+                       char *table,
+                       char *column,
+                       int encoding) {
   BlobHandle *blob = ALLOC(BlobHandle);
 
   if(blob != NULL) {
-    ISC_STATUS status[ISC_STATUS_LENGTH];
-
-    /* Extract the blob details and open it. */
-    blob->handle = 0;
-    blob->charset = blobEntry->sqlscale;
+    blob->id       = *(ISC_QUAD *)blobEntry->sqldata;
+    blob->segments = blob->size = blob->maximum = blob->position = 0;
+    blob->handle   = 0;
+    blob->encoding = encoding;
+    blob->eof      = 0;
+    blob->deferred = 1;
     isc_blob_default_desc(&blob->description,
                           (unsigned char *)table,
                           (unsigned char *)column);
-    if(isc_open_blob2(status, &cHandle->handle, &tHandle->handle, &blob->handle, &blobId,
-                      0, NULL) == 0) {
-      char items[] = {isc_info_blob_num_segments,
-                      isc_info_blob_total_length},
-           data[]  = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                      0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-      if(isc_blob_info(status, &blob->handle, 2, items, 20, data) == 0) {
-        int offset = 0,
-            done   = 0;
-
-        while(done < 2) {
-          int length = isc_vax_integer(&data[offset + 1], 2);
-
-          if(data[offset] == isc_info_blob_num_segments) {
-            blob->segments = isc_vax_integer(&data[offset + 3], length);
-            done++;
-          } else if(data[offset] == isc_info_blob_total_length) {
-            blob->size = isc_vax_integer(&data[offset + 3], length);
-            done++;
-          } else {
-            free(blob);
-            rb_fireruby_raise(NULL, "Error reading blob details.");
-          }
-          offset += length + 3;
-        }
-      } else {
-        free(blob);
-        rb_fireruby_raise(status, "Error fetching blob details.");
-      }
-    } else {
-      free(blob);
-      rb_fireruby_raise(status, "Error opening blob.");
-    }
+  } else {
+    rb_raise(rb_eNoMemError, "Memory allocation failure allocating a blob.");
   }
 
   return(blob);
@@ -252,88 +594,78 @@ BlobHandle *openBlob(XSQLVAR *blobEntry,
 
 
 /**
- * This function fetches the data associated with a blob.
+ * This function opens a blob created by createBlob and fetches the blob
+ * details. If the open fails the blob is left unopened.
  *
- * @param  blob  A pointer to the BlobHandle structure that will be used in
- *               loading the data.
- *
- * @return  A pointer to an array of character data containing the data of the
- *          blob.
+ * @param  blob         A pointer to the BlobHandle structure to be opened.
+ * @param  connection   The connection to be used in accessing the blob.
+ * @param  transaction  The transaction to be used in accessing the blob.
  *
  */
-char *loadBlobData(BlobHandle *blob) {
-  char *data = NULL;
-
-  if(blob != NULL && blob->handle != 0) {
-    if((data = ALLOC_N(char, blob->size)) != NULL) {
-      ISC_STATUS status[ISC_STATUS_LENGTH],
-                 result = 0;
-      int offset = 0;
-
-      while(result == 0 || result == isc_segment) {
-        unsigned short quantity  = 0,
-                       available = 0;
-        int remains   = blob->size - offset;
-
-        available = remains > USHRT_MAX ? USHRT_MAX : remains;
-        result    = isc_get_segment(status, &blob->handle, &quantity,
-                                    available, &data[offset]);
-        if(result != 0 && result != isc_segment && result != isc_segstr_eof) {
-          free(data);
-          rb_fireruby_raise(status, "Error loading blob data.");
-        }
-        offset = offset + quantity;
-      }
+void openBlob(BlobHandle *blob, VALUE connection, VALUE transaction) {
+  ConnectionHandle  *cHandle    = NULL;
+  TransactionHandle *tHandle    = NULL;
+  ISC_STATUS        status[ISC_STATUS_LENGTH];
+  char              items[] = {isc_info_blob_num_segments,
+                               isc_info_blob_total_length,
+                               isc_info_blob_max_segment},
+                    data[]  = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                               0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                               0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  int               offset = 0,
+                    done   = 0;
+
+  Data_Get_Struct(connection, ConnectionHandle, cHandle);
+  Data_Get_Struct(transaction, TransactionHandle, tHandle);
+  if(isc_open_blob2(status, &cHandle->handle, &tHandle->handle, &blob->handle,
+                    &blob->id, 0, NULL) != 0) {
+    blob->handle = 0;
+    rb_fireruby_raise(status, "Error opening blob.");
+  }
+
+  if(isc_blob_info(status, &blob->handle, 3, items, 30, data) != 0) {
+    ISC_STATUS ignored[ISC_STATUS_LENGTH];
+
+    isc_close_blob(ignored, &blob->handle);
+    blob->handle = 0;
+    rb_fireruby_raise(status, "Error fetching blob details.");
+  }
+  while(done < 3) {
+    int length = isc_vax_integer(&data[offset + 1], 2);
+
+    if(data[offset] == isc_info_blob_num_segments) {
+      blob->segments = isc_vax_integer(&data[offset + 3], length);
+      done++;
+    } else if(data[offset] == isc_info_blob_total_length) {
+      blob->size = isc_vax_integer(&data[offset + 3], length);
+      done++;
+    } else if(data[offset] == isc_info_blob_max_segment) {
+      blob->maximum = isc_vax_integer(&data[offset + 3], length);
+      done++;
     } else {
-      rb_raise(rb_eNoMemError,
-               "Memory allocation failure loading blob data.");
+      isc_close_blob(status, &blob->handle);
+      blob->handle = 0;
+      rb_fireruby_raise(NULL, "Error reading blob details.");
     }
-  } else {
-    rb_fireruby_raise(NULL, "Invalid blob specified for loading.");
+    offset += length + 3;
   }
-
-  return(data);
+  blob->deferred = 0;
 }
 
 
 /**
- * This function fetches the data for a single segment associated with a Blob.
- *
- * @param  blob    A pointer to the BlobHandle structure that will be used in
- *                 fetching a blob segment.
- * @param  length  A pointer to an short integer that will be set to the amount
- *                 of data read in bytes.
+ * This function opens the blob for a Blob object if that has been deferred
+ * since the blob was fetched.
  *
- * @return  A pointer to a block of memory containing the next blob segement
- *          data. The return value will be NULL when there are no more blob
- *          segements to be read.
+ * @param  self  A reference to the Blob object.
+ * @param  blob  A pointer to the BlobHandle for the Blob object.
  *
  */
-char *loadBlobSegment(BlobHandle *blob, unsigned short *length) {
-  char *data = NULL;
-
-  *length = 0;
-  if(blob != NULL && blob->handle != 0) {
-    unsigned short size = blob->description.blob_desc_segment_size;
-
-    if((data = ALLOC_N(char, size)) != NULL) {
-      ISC_STATUS status[ISC_STATUS_LENGTH],
-                 result;
-
-      result = isc_get_segment(status, &blob->handle, length, size, data);
-      if(result != 0 && result != isc_segstr_eof) {
-        free(data);
-        rb_fireruby_raise(status, "Error reading blob segment.");
-      }
-    } else {
-      rb_raise(rb_eNoMemError,
-               "Memory allocation failre loading blob segment.");
-    }
-  } else {
-    rb_fireruby_raise(NULL, "Invalid blob specified for loading.");
+static void prepareBlob(VALUE self, BlobHandle *blob) {
+  if(blob->deferred) {
+    openBlob(blob, rb_iv_get(self, "@connection"),
+             rb_iv_get(self, "@transaction"));
   }
-
-  return(data);
 }
 
 
@@ -375,5 +707,10 @@ void Init_Blob(VALUE module) {
   rb_define_method(cBlob, "initialize_copy", forbidObjectCopy, 1);
   rb_define_method(cBlob, "to_s", getBlobData, 0);
   rb_define_method(cBlob, "close", closeBlob, 0);
-  rb_define_method(cBlob, "each", eachBlobSegment, 0);
+  rb_define_method(cBlob, "each", eachBlobSegment, -1);
+  rb_define_method(cBlob, "read", readBlob, -1);
+  rb_define_method(cBlob, "readpartial", readPartialBlob, -1);
+  rb_define_method(cBlob, "eof?", getBlobEOF, 0);
+  rb_define_alias(cBlob, "eof", "eof?");
+  rb_define_method(cBlob, "size", getBlobSize, 0);
 }
@@ -46,23 +46,29 @@
 /* Type definitions. */
 typedef struct {
   ISC_BLOB_DESC description;
+  ISC_QUAD id;
   ISC_LONG segments,
-           size;
+           size,
+           maximum,
+           position;
   isc_blob_handle handle;
-  short charset;
+  int encoding;
+  short eof,
+        deferred;
 } BlobHandle;
 
 /* Data elements. */
 extern VALUE cBlob;
 
 /* Function prototypes. */
-BlobHandle *openBlob(XSQLVAR *,
-                     char *,
-                     char *,
-                     VALUE,
-                     VALUE);
+BlobHandle *createBlob(XSQLVAR *,
+                       char *,
+                       char *,
+                       int);
+void openBlob(BlobHandle *, VALUE, VALUE);
 void Init_Blob(VALUE);
 void blobFree(void *);
 VALUE initializeBlob(VALUE, VALUE);
+VALUE inlineBlob(BlobHandle *, long, VALUE, VALUE);
 
 #endif /* FIRERUBY_BLOB_H */
@@ -29,6 +29,8 @@
 #include "Statement.h"
 #include "Transaction.h"
 #include "Common.h"
+#include "rfbgvl.h"
+#include "rfbstr.h"
 
 /* Function prototypes. */
 static VALUE allocateConnection(VALUE);
@@ -44,9 +46,13 @@ static VALUE executeOnConnectionWithParams(VALUE, VALUE, VALUE, VALUE);
 static VALUE executeOnConnectionImmediate(VALUE, VALUE);
 static VALUE createStatement(VALUE, VALUE);
 static VALUE getConnectionUser(VALUE);
+static VALUE getStatementCacheSize(VALUE);
+static VALUE setStatementCacheSize(VALUE, VALUE);
+static VALUE getStatementCacheStats(VALUE);
 VALUE startTransactionBlock(VALUE);
 VALUE startTransactionRescue(VALUE, VALUE);
 char *createDPB(VALUE, VALUE, VALUE, short *);
+static void resetConnectionEncodings(ConnectionHandle *);
 
 /* Globals. */
 VALUE cConnection;
@@ -67,7 +73,13 @@ static VALUE allocateConnection(VALUE klass) {
 
   if(connection != NULL) {
     /* Wrap the structure in a class. */
-    connection->handle = 0;
+    connection->handle          = 0;
+    connection->cache_size      = 0;
+    connection->cache_hits      = 0;
+    connection->cache_misses    = 0;
+    connection->cache_evictions = 0;
+    connection->generation      = 0;
+    resetConnectionEncodings(connection);
     instance = Data_Wrap_Struct(klass, NULL, connectionFree, connection);
   } else {
     rb_raise(rb_eNoMemError,
@@ -78,6 +90,53 @@ static VALUE allocateConnection(VALUE klass) {
 }
 
 
+/**
+ * This function marks all of the character set encodings for a connection as
+ * unresolved, so that they are looked up again when next needed.
+ *
+ * @param  connection  A pointer to the connection handle.
+ *
+ */
+static void resetConnectionEncodings(ConnectionHandle *connection) {
+  int index;
+
+  for(index = 0; index < 256; index++) {
+    connection->encodings[index] = -1;
+  }
+}
+
+
+/**
+ * This function fetches the index of the Ruby encoding matching a database
+ * character set for a connection. The encoding is looked up in the character
+ * set map built when the connection was opened and remembered thereafter.
+ *
+ * @param  self     A reference to the Connection object.
+ * @param  charset  The database character set identifier, as held in the
+ *                  sub type of text columns or the scale of blob columns.
+ *
+ * @return  The index of the matching Ruby encoding.
+ *
+ */
+int getConnectionEncoding(VALUE self, short charset) {
+  ConnectionHandle *connection = NULL;
+  int              id          = charset & 0xFF;
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+  if(connection->encodings[id] < 0) {
+    VALUE map  = rb_iv_get(self, "@charset_map"),
+          name = Qnil;
+
+    if(map != Qnil) {
+      name = rb_hash_aref(map, INT2FIX(id));
+    }
+    connection->encodings[id] = rfbencoding(name);
+  }
+
+  return(connection->encodings[id]);
+}
+
+
 /**
  * This function provides the initialize method for the Connection class.
  *
@@ -128,7 +187,7 @@ static VALUE initializeConnection(int argc, VALUE *argv, VALUE self) {
 
   /* Open the connection connection. */
   dpb = createDPB(user, password, options, &length);
-  attach_result = isc_attach_database(status, strlen(file), file, &connection->handle, length, dpb);
+  attach_result = rfb_attach_database(status, strlen(file), file, &connection->handle, length, dpb);
   free(dpb);
 
   if(attach_result != 0) {
@@ -140,7 +199,10 @@ static VALUE initializeConnection(int argc, VALUE *argv, VALUE self) {
   rb_iv_set(self, "@database", argv[0]);
   rb_iv_set(self, "@user", user);
   rb_iv_set(self, "@transactions", rb_ary_new());
+  rb_iv_set(self, "@statement_cache", rb_hash_new());
+  rb_iv_set(self, "@bulk_writers", rb_hash_new());
   rb_funcall(self, rb_intern("init_m17n"), 0);
+  resetConnectionEncodings(connection);
   
   return(self);
 }
@@ -208,6 +270,9 @@ static VALUE closeConnection(VALUE self) {
       }
     }
 
+    /* Drop any cached statements. */
+    clearStatementCache(self);
+
     /* Detach from the database. */
     if(isc_detach_database(status, &connection->handle) == 0) {
       connection->handle = 0;
@@ -651,6 +716,234 @@ void rb_tx_released(VALUE connection, VALUE transaction) {
 }
 
 
+/**
+ * This function is used with rb_hash_foreach to collect the values from a
+ * Hash into an Array, in insertion order. When the target does not hold an
+ * Array the key of the first entry is stored in it instead.
+ *
+ * @param  key    A reference to the key of the Hash entry.
+ * @param  value  A reference to the value of the Hash entry.
+ * @param  array  A pointer to the VALUE holding the Array or to receive the
+ *                key.
+ *
+ * @return  ST_CONTINUE, or ST_STOP once the first key has been fetched.
+ *
+ */
+static int collectCacheEntry(VALUE key, VALUE value, VALUE array) {
+  VALUE *target = (VALUE *)array;
+
+  if(TYPE(*target) == T_ARRAY) {
+    rb_ary_push(*target, value);
+    return(ST_CONTINUE);
+  }
+  *target = key;
+
+  return(ST_STOP);
+}
+
+
+/**
+ * This function evicts the least recently used statements from the statement
+ * cache of a connection until the cache holds no more than a given number of
+ * statements.
+ *
+ * @param  self        A reference to the Connection object.
+ * @param  connection  A pointer to the ConnectionHandle for the connection.
+ * @param  size        The number of statements to trim the cache down to.
+ *
+ */
+static void trimStatementCache(VALUE self, ConnectionHandle *connection,
+                               long size) {
+  VALUE cache = rb_iv_get(self, "@statement_cache");
+
+  while(cache != Qnil && (long)RHASH_SIZE(cache) > size) {
+    VALUE key = Qnil;
+
+    rb_hash_foreach(cache, collectCacheEntry, (VALUE)&key);
+    rb_funcall(rb_hash_delete(cache, key), rb_intern("close"), 0);
+    connection->cache_evictions++;
+  }
+}
+
+
+/**
+ * This function takes a prepared statement for a piece of SQL out of the
+ * statement cache of a connection. The statement stays out of the cache, and
+ * so can not be handed out twice, until it is checked back in.
+ *
+ * @param  self        A reference to the Connection object.
+ * @param  sql         A reference to the SQL text to fetch a statement for.
+ * @param  generation  A pointer to be set to the current generation of the
+ *                     cache, which must be passed back to checkinStatement.
+ *
+ * @return  A reference to a prepared Statement object, or nil if the cache is
+ *          disabled or holds no statement for the SQL.
+ *
+ */
+VALUE checkoutStatement(VALUE self, VALUE sql, unsigned long *generation) {
+  ConnectionHandle *connection = NULL;
+  VALUE cache     = rb_iv_get(self, "@statement_cache"),
+        statement = Qnil;
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+  *generation = connection->generation;
+  if(connection->cache_size > 0 && cache != Qnil && TYPE(sql) == T_STRING) {
+    statement = rb_hash_delete(cache, sql);
+    if(statement != Qnil) {
+      connection->cache_hits++;
+    } else {
+      connection->cache_misses++;
+    }
+  }
+
+  return(statement);
+}
+
+
+/**
+ * This function returns a prepared statement to the statement cache of a
+ * connection, making it the most recently used entry.
+ *
+ * @param  self        A reference to the Connection object.
+ * @param  sql         A reference to the SQL text for the statement.
+ * @param  statement   A reference to the prepared Statement object.
+ * @param  generation  The cache generation returned by checkoutStatement. A
+ *                     statement checked out before the cache was last
+ *                     cleared is not cached again.
+ *
+ * @return  1 if the statement was cached, 0 if the cache is disabled, the
+ *          connection is closed or the cache has been cleared since the
+ *          statement was checked out, in which case the caller remains
+ *          responsible for closing the statement.
+ *
+ */
+short checkinStatement(VALUE self, VALUE sql, VALUE statement,
+                       unsigned long generation) {
+  ConnectionHandle *connection = NULL;
+  VALUE cache    = rb_iv_get(self, "@statement_cache"),
+        existing = Qnil;
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+  if(connection->cache_size <= 0 || connection->handle == 0 || cache == Qnil ||
+     connection->generation != generation) {
+    return(0);
+  }
+
+  existing = rb_hash_delete(cache, sql);
+  if(existing != Qnil) {
+    rb_funcall(existing, rb_intern("close"), 0);
+  }
+  rb_hash_aset(cache, sql, statement);
+  trimStatementCache(self, connection, connection->cache_size);
+
+  return(1);
+}
+
+
+/**
+ * This function closes and drops all of the statements in the statement
+ * cache of a connection, along with the bulk writers cached by bulk_insert.
+ * Statements checked out at the time are kept out of the cache when they are
+ * checked back in.
+ *
+ * @param  self  A reference to the Connection object.
+ *
+ */
+void clearStatementCache(VALUE self) {
+  ConnectionHandle *connection = NULL;
+  VALUE caches[]   = {rb_iv_get(self, "@statement_cache"),
+                      rb_iv_get(self, "@bulk_writers")},
+        statements = rb_ary_new();
+  long  index;
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+  connection->generation++;
+  for(index = 0; index < 2; index++) {
+    if(caches[index] != Qnil && RHASH_SIZE(caches[index]) > 0) {
+      rb_hash_foreach(caches[index], collectCacheEntry, (VALUE)&statements);
+      rb_hash_clear(caches[index]);
+    }
+  }
+  for(index = 0; index < RARRAY_LEN(statements); index++) {
+    rb_funcall(rb_ary_entry(statements, index), rb_intern("close"), 0);
+  }
+}
+
+
+/**
+ * This function provides the statement_cache_size method for the Connection
+ * class.
+ *
+ * @param  self  A reference to the Connection object.
+ *
+ * @return  A reference to an Integer containing the maximum number of
+ *          statements the connection caches.
+ *
+ */
+static VALUE getStatementCacheSize(VALUE self) {
+  ConnectionHandle *connection = NULL;
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+
+  return(LONG2NUM(connection->cache_size));
+}
+
+
+/**
+ * This function provides the statement_cache_size= method for the Connection
+ * class. Setting a size of zero disables the cache.
+ *
+ * @param  self  A reference to the Connection object.
+ * @param  size  The maximum number of statements to be cached.
+ *
+ * @return  A reference to the size set.
+ *
+ */
+static VALUE setStatementCacheSize(VALUE self, VALUE size) {
+  ConnectionHandle *connection = NULL;
+  long             count       = NUM2LONG(size);
+
+  if(count < 0) {
+    rb_raise(rb_eArgError, "Invalid statement cache size (%ld) specified.",
+             count);
+  }
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+  connection->cache_size = count;
+  trimStatementCache(self, connection, count);
+
+  return(size);
+}
+
+
+/**
+ * This function provides the statement_cache_stats method for the Connection
+ * class.
+ *
+ * @param  self  A reference to the Connection object.
+ *
+ * @return  A reference to a Hash containing the size, capacity, hits, misses
+ *          and evictions of the statement cache.
+ *
+ */
+static VALUE getStatementCacheStats(VALUE self) {
+  ConnectionHandle *connection = NULL;
+  VALUE cache = rb_iv_get(self, "@statement_cache"),
+        stats = rb_hash_new();
+
+  Data_Get_Struct(self, ConnectionHandle, connection);
+  rb_hash_aset(stats, toSymbol("size"),
+               LONG2NUM(cache == Qnil ? 0 : (long)RHASH_SIZE(cache)));
+  rb_hash_aset(stats, toSymbol("capacity"), LONG2NUM(connection->cache_size));
+  rb_hash_aset(stats, toSymbol("hits"), ULONG2NUM(connection->cache_hits));
+  rb_hash_aset(stats, toSymbol("misses"), ULONG2NUM(connection->cache_misses));
+  rb_hash_aset(stats, toSymbol("evictions"),
+               ULONG2NUM(connection->cache_evictions));
+
+  return(stats);
+}
+
+
 /**
  * This function initializes the Connection class within the Ruby environment.
  * The class is established under the module specified to the function.
@@ -674,6 +967,9 @@ void Init_Connection(VALUE module) {
   rb_define_method(cConnection, "execute_for", executeOnConnectionWithParams, 3);
   rb_define_method(cConnection, "execute_immediate", executeOnConnectionImmediate, 1);
   rb_define_method(cConnection, "create_statement", createStatement, 1);
+  rb_define_method(cConnection, "statement_cache_size", getStatementCacheSize, 0);
+  rb_define_method(cConnection, "statement_cache_size=", setStatementCacheSize, 1);
+  rb_define_method(cConnection, "statement_cache_stats", getStatementCacheStats, 0);
 
   rb_define_const(cConnection, "MARK_DATABASE_DAMAGED", INT2FIX(isc_dpb_damaged));
   rb_define_const(cConnection, "WRITE_POLICY", INT2FIX(isc_dpb_force_write));
@@ -37,6 +37,12 @@
 /* Structure definitions. */
 typedef struct {
   isc_db_handle handle;
+  long          cache_size;
+  unsigned long cache_hits,
+                cache_misses,
+                cache_evictions,
+                generation;
+  int           encodings[256];
 } ConnectionHandle;
 
 /* Function prototypes. */
@@ -45,5 +51,9 @@ VALUE rb_connection_new(VALUE, VALUE, VALUE, VALUE);
 void rb_tx_started(VALUE, VALUE);
 void rb_tx_released(VALUE, VALUE);
 void connectionFree(void *);
+VALUE checkoutStatement(VALUE, VALUE, unsigned long *);
+short checkinStatement(VALUE, VALUE, VALUE, unsigned long);
+void clearStatementCache(VALUE);
+int getConnectionEncoding(VALUE, short);
 
 #endif /* FIRERUBY_CONNECTION_H */
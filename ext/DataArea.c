@@ -28,6 +28,9 @@
 #include "FireRubyException.h"
 #include "rfbint.h"
 
+/* Round a field size up to keep the data for each field aligned. */
+#define DATA_AREA_ALIGN(size)  (((size) + 7) & ~7L)
+
 /**
  * This function allocates the memory for a output XSQLDA based on a specified
  * XSQLDA providing base details.
@@ -103,146 +106,266 @@ XSQLDA *allocateInXSQLDA(int size, isc_stmt_handle *statement, short dialect) {
 
 
 /**
- * This function initializes a previously allocated XSQLDA with space for the
- * data it will contain.
+ * This function copies a name returned by isc_dsql_sql_info into one of the
+ * fixed size name fields of a XSQLVAR, truncating it if needed.
  *
- * @param  da  A pointer to the XSQLDA to have data space allocated for.
+ * @param  target  A pointer to the name field to be filled in.
+ * @param  length  A pointer to the length field for the name.
+ * @param  limit   The size of the name field.
+ * @param  source  A pointer to the name in the information buffer.
+ * @param  size    The length of the name in the information buffer.
  *
  */
-void prepareDataArea(XSQLDA *da) {
-  XSQLVAR *field = da->sqlvar;
-  int index;
+static void copyInfoName(char *target, short *length, short limit,
+                         const char *source, short size) {
+  *length = (size < limit ? size : limit);
+  memcpy(target, source, *length);
+}
 
-  for(index = 0; index < da->sqld; index++, field++) {
-    int type  = (field->sqltype & ~1),
-        total = (field->sqllen / 2) + 2;
 
-    field->sqldata = NULL;
-    field->sqlind  = NULL;
-    switch(type) {
-    case SQL_ARRAY:
-      fprintf(stderr, "Allocating for an array (NOT).\n");
-      break;
+/**
+ * This function builds a XSQLDA from the describe information returned for a
+ * statement by isc_dsql_sql_info, filling it in exactly as isc_dsql_describe
+ * or isc_dsql_describe_bind would without another call to the server.
+ *
+ * @param  position  A pointer to the start of the select or bind details in
+ *                   the information buffer, just past the isc_info_sql_select
+ *                   or isc_info_sql_bind item.
+ * @param  end       A pointer to the end of the information buffer.
+ * @param  count     A pointer to an integer that will be assigned the number
+ *                   of variables described, or -1 if it could not be read.
+ * @param  area      A pointer that will be assigned the newly allocated
+ *                   XSQLDA, or NULL if there are no variables or the details
+ *                   were incomplete.
+ *
+ * @return  A pointer to the information following the XSQLDA details, or NULL
+ *          if the details were truncated.
+ *
+ */
+char *parseXSQLDAInfo(char *position, char *end, int *count, XSQLDA **area) {
+  XSQLVAR *var   = NULL;
+  int     index  = 0;
+  short   length = 0;
+
+  *count = -1;
+  *area  = NULL;
+  if(end - position < 3 || *position != isc_info_sql_describe_vars) {
+    return(NULL);
+  }
+  length    = (short)isc_vax_integer(position + 1, 2);
+  position += 3;
+  if(end - position < length) {
+    return(NULL);
+  }
+  *count    = isc_vax_integer(position, length);
+  position += length;
+  if(*count == 0) {
+    return(position);
+  }
 
-    case SQL_BLOB:
-      field->sqldata = (char *)ALLOC(ISC_QUAD);
-      break;
+  *area = (XSQLDA *)ALLOC_N(char, XSQLDA_LENGTH(*count));
+  if(*area == NULL) {
+    rb_raise(rb_eNoMemError,
+             "Memory allocation failure preparing SQL data definition area.");
+  }
+  memset(*area, 0, XSQLDA_LENGTH(*count));
+  (*area)->version = SQLDA_VERSION1;
+  (*area)->sqln    = *count;
+  (*area)->sqld    = *count;
+
+  while(position < end) {
+    char item = *position++;
+
+    if(item == isc_info_sql_describe_end) {
+      if(index == *count) {
+        return(position);
+      }
+      continue;
+    }
 
-    case SQL_DOUBLE:
-      field->sqldata = (char *)ALLOC(double);
+    if(item < isc_info_sql_sqlda_seq || item > isc_info_sql_alias ||
+       end - position < 2) {
+      /* Truncated or unexpected details. */
       break;
-
-    case SQL_FLOAT:
-      field->sqldata = (char *)ALLOC(float);
+    }
+    length    = (short)isc_vax_integer(position, 2);
+    position += 2;
+    if(end - position < length) {
       break;
+    }
 
-    case SQL_INT64:
-      field->sqldata = (char *)ALLOC(int64_t);
-      break;
+    if(item == isc_info_sql_sqlda_seq) {
+      index = isc_vax_integer(position, length);
+      if(index < 1 || index > *count) {
+        break;
+      }
+      var = &(*area)->sqlvar[index - 1];
+    } else if(var != NULL) {
+      switch(item) {
+      case isc_info_sql_type:
+        var->sqltype = (short)isc_vax_integer(position, length);
+        break;
+
+      case isc_info_sql_sub_type:
+        var->sqlsubtype = (short)isc_vax_integer(position, length);
+        break;
+
+      case isc_info_sql_scale:
+        var->sqlscale = (short)isc_vax_integer(position, length);
+        break;
+
+      case isc_info_sql_length:
+        var->sqllen = (short)isc_vax_integer(position, length);
+        break;
+
+      case isc_info_sql_field:
+        copyInfoName(var->sqlname, &var->sqlname_length,
+                     sizeof(var->sqlname), position, length);
+        break;
+
+      case isc_info_sql_relation:
+        copyInfoName(var->relname, &var->relname_length,
+                     sizeof(var->relname), position, length);
+        break;
+
+      case isc_info_sql_owner:
+        copyInfoName(var->ownname, &var->ownname_length,
+                     sizeof(var->ownname), position, length);
+        break;
+
+      case isc_info_sql_alias:
+        copyInfoName(var->aliasname, &var->aliasname_length,
+                     sizeof(var->aliasname), position, length);
+        break;
+      }
+    }
+    position += length;
+  }
 
-    case SQL_LONG:
-      field->sqldata = (char *)ALLOC(int32_t);
-      break;
+  free(*area);
+  *area = NULL;
 
-    case SQL_SHORT:
-      field->sqldata = (char *)ALLOC(int16_t);
-      break;
+  return(NULL);
+}
 
-    case SQL_TEXT:
-      field->sqldata = ALLOC_N(char, field->sqllen + 1);
-      break;
 
-    case SQL_TIMESTAMP:
-      field->sqldata = (char *)ALLOC(ISC_TIMESTAMP);
-      break;
+/**
+ * This function determines the amount of storage needed to hold the data for
+ * a XSQLDA field.
+ *
+ * @param  field  A pointer to the XSQLVAR to size the storage for.
+ *
+ * @return  The number of bytes of storage needed for the field.
+ *
+ */
+static long getFieldSize(XSQLVAR *field) {
+  long size = 0;
 
-    case SQL_TYPE_DATE:
-      field->sqldata = (char *)ALLOC(ISC_DATE);
-      break;
+  switch(field->sqltype & ~1) {
+  case SQL_ARRAY:
+  case SQL_BLOB:
+    size = sizeof(ISC_QUAD);
+    break;
 
-    case SQL_TYPE_TIME:
-      field->sqldata = (char *)ALLOC(ISC_TIME);
-      break;
+  case SQL_DOUBLE:
+    size = sizeof(double);
+    break;
 
-    case SQL_VARYING:
-      field->sqldata = (char *)ALLOC_N(short, total);
-      break;
+  case SQL_FLOAT:
+    size = sizeof(float);
+    break;
 
-    default:
-      rb_fireruby_raise(NULL, "Unknown SQL data type encountered.");
-    }
-    field->sqlind  = ALLOC(short);
-    *field->sqlind = 0;
-  }
-}
+  case SQL_INT64:
+    size = sizeof(int64_t);
+    break;
 
+  case SQL_LONG:
+    size = sizeof(int32_t);
+    break;
 
-/**
- * This method cleans up all the internal memory associated with a XSQLDA.
- *
- * @param  da  A reference to the XSQLDA to be cleared up.
- *
- */
-void releaseDataArea(XSQLDA *da) {
-  XSQLVAR *field = da->sqlvar;
-  int index;
+  case SQL_SHORT:
+    size = sizeof(int16_t);
+    break;
 
-  for(index = 0; index < da->sqld; index++, field++) {
-    int type  = (field->sqltype & ~1);
+  case SQL_TEXT:
+    size = field->sqllen + 1;
+    break;
 
-    switch(type) {
-    case SQL_ARRAY:
-      fprintf(stderr, "Releasing an array (NOT).\n");
-      break;
+  case SQL_TIMESTAMP:
+    size = sizeof(ISC_TIMESTAMP);
+    break;
 
-    case SQL_BLOB:
-      free((ISC_QUAD *)field->sqldata);
-      break;
+  case SQL_TYPE_DATE:
+    size = sizeof(ISC_DATE);
+    break;
 
-    case SQL_DOUBLE:
-      free((double *)field->sqldata);
-      break;
+  case SQL_TYPE_TIME:
+    size = sizeof(ISC_TIME);
+    break;
 
-    case SQL_FLOAT:
-      free((float *)field->sqldata);
-      break;
+  case SQL_VARYING:
+    size = sizeof(short) * ((field->sqllen / 2) + 2);
+    break;
 
-    case SQL_INT64:
-      free((int64_t *)field->sqldata);
-      break;
+  default:
+    rb_fireruby_raise(NULL, "Unknown SQL data type encountered.");
+  }
 
-    case SQL_LONG:
-      free((int32_t *)field->sqldata);
-      break;
+  return(size);
+}
 
-    case SQL_SHORT:
-      free((int16_t *)field->sqldata);
-      break;
 
-    case SQL_TEXT:
-      free(field->sqldata);
-      break;
+/**
+ * This function initializes a previously allocated XSQLDA with space for the
+ * data it will contain. The data and null indicators for all of the fields
+ * are carved out of a single block of memory, with the data for each field
+ * aligned to an eight byte boundary and the indicators following the data.
+ * The block is anchored at the data pointer of the first field.
+ *
+ * @param  da  A pointer to the XSQLDA to have data space allocated for.
+ *
+ */
+void prepareDataArea(XSQLDA *da) {
+  XSQLVAR *field = da->sqlvar;
+  char    *block = NULL;
+  long    total  = 0,
+          offset = 0;
+  int     index;
 
-    case SQL_TIMESTAMP:
-      free((ISC_TIMESTAMP *)field->sqldata);
-      break;
+  for(index = 0; index < da->sqld; index++, field++) {
+    field->sqldata = NULL;
+    field->sqlind  = NULL;
+    total += DATA_AREA_ALIGN(getFieldSize(field));
+  }
+  if(da->sqld == 0) {
+    return;
+  }
 
-    case SQL_TYPE_DATE:
-      free((ISC_DATE *)field->sqldata);
-      break;
+  block = ALLOC_N(char, total + (sizeof(short) * da->sqld));
+  memset(block, 0, total + (sizeof(short) * da->sqld));
+  field = da->sqlvar;
+  for(index = 0; index < da->sqld; index++, field++) {
+    field->sqldata = &block[offset];
+    field->sqlind  = (short *)&block[total + (sizeof(short) * index)];
+    offset        += DATA_AREA_ALIGN(getFieldSize(field));
+  }
+}
 
-    case SQL_TYPE_TIME:
-      free((ISC_TIME *)field->sqldata);
-      break;
 
-    case SQL_VARYING:
-      free((short *)field->sqldata);
-      break;
-    }
-    if(field->sqlind != NULL) {
-      free(field->sqlind);
-    }
+/**
+ * This method cleans up all the internal memory associated with a XSQLDA.
+ *
+ * @param  da  A reference to the XSQLDA to be cleared up.
+ *
+ */
+void releaseDataArea(XSQLDA *da) {
+  XSQLVAR *field = da->sqlvar;
+  int index;
 
+  if(da->sqld > 0 && field->sqldata != NULL) {
+    free(field->sqldata);
+  }
+  for(index = 0; index < da->sqld; index++, field++) {
     field->sqldata = NULL;
     field->sqlind  = NULL;
   }
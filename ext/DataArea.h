@@ -32,6 +32,7 @@
 
 XSQLDA *allocateOutXSQLDA(int, isc_stmt_handle *, short);
 XSQLDA *allocateInXSQLDA(int, isc_stmt_handle *, short);
+char *parseXSQLDAInfo(char *, char *, int *, XSQLDA **);
 void prepareDataArea(XSQLDA *);
 void releaseDataArea(XSQLDA *);
 
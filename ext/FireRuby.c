@@ -34,6 +34,8 @@
 #include "FireRubyException.h"
 #include "Generator.h"
 #include "RemoveUser.h"
+#include "ResultSet.h"
+#include "Row.h"
 #include "ServiceManager.h"
 #include "Statement.h"
 #include "Transaction.h"
@@ -190,6 +192,11 @@ void Init_rubyfb_lib(void) {
   rb_ary_push(array, INT2FIX(BUILD_NO));
   rb_hash_aset(hash, toSymbol("ALIAS_KEYS"), Qtrue);
   rb_hash_aset(hash, toSymbol("DATE_AS_DATE"), Qtrue);
+  rb_hash_aset(hash, toSymbol("DECIMAL_MODE"), toSymbol("float"));
+  rb_hash_aset(hash, toSymbol("INTERN_STRINGS"), Qfalse);
+  rb_hash_aset(hash, toSymbol("TRIM_CHAR"), Qfalse);
+  rb_hash_aset(hash, toSymbol("LAZY_ROWS"), Qfalse);
+  rb_hash_aset(hash, toSymbol("INLINE_BLOBS"), INT2FIX(0));
   rb_gv_set("$FireRubyVersion", array);
   rb_gv_set("$FireRubySettings", hash);
 
@@ -202,6 +209,8 @@ void Init_rubyfb_lib(void) {
   Init_Transaction(module);
   Init_TypeMap(module);
   Init_Statement(module);
+  Init_ResultSet(module);
+  Init_Row(module);
   Init_Generator(module);
   Init_FireRubyException(module);
   Init_Blob(module);
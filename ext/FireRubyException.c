@@ -135,6 +135,9 @@ void rb_fireruby_raise(const ISC_STATUS *status, const char *prefix) {
       dbCode  = 0;
   const ISC_STATUS **ptr   = &status;
 
+  /* An interrupt that cancelled the failed operation takes precedence. */
+  rb_thread_check_ints();
+
   /* Add the prefix message if it exists. */
   if(prefix != NULL && strlen(prefix) > 0) {
     rb_str_concat(message, rb_str_new2(prefix));
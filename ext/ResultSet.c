@@ -0,0 +1,807 @@
+/*------------------------------------------------------------------------------
+ * ResultSet.c
+ *----------------------------------------------------------------------------*/
+
+/* Includes. */
+#include "ResultSet.h"
+#include "Common.h"
+#include "Row.h"
+#include "Statement.h"
+
+/* Function prototypes. */
+static VALUE allocateResultSet(VALUE);
+static VALUE initializeResultSet(VALUE, VALUE, VALUE);
+static VALUE getResultSetStatement(VALUE);
+static VALUE getResultSetTransaction(VALUE);
+static VALUE getResultSetRowCount(VALUE);
+static VALUE eachResultSetRow(VALUE);
+static VALUE eachResultSetArray(VALUE);
+static VALUE eachResultSetHash(VALUE);
+static VALUE resultSetToArray(VALUE);
+static VALUE fetchResultSetRow(VALUE);
+static VALUE closeResultSet(VALUE);
+static VALUE getResultSetConnection(VALUE);
+static VALUE getResultSetSQL(VALUE);
+static VALUE getResultSetDialect(VALUE);
+static VALUE getResultSetColumnName(VALUE, VALUE);
+static VALUE getResultSetColumnAlias(VALUE, VALUE);
+static VALUE getResultSetColumnScale(VALUE, VALUE);
+static VALUE getResultSetColumnTable(VALUE, VALUE);
+static VALUE getResultSetColumnBaseType(VALUE, VALUE);
+static VALUE getResultSetColumnCount(VALUE);
+static VALUE getResultSetActive(VALUE);
+static VALUE getResultSetExhausted(VALUE);
+static void resultSetMark(void *);
+static void resultSetFree(void *);
+
+/* Globals. */
+VALUE cResultSet;
+
+static ID
+  RB_INTERN_AT_NAME,
+  RB_INTERN_AT_ALIAS,
+  RB_INTERN_AT_TYPE,
+  RB_INTERN_AT_SCALE,
+  RB_INTERN_AT_RELATION,
+  RB_INTERN_AT_KEY,
+  RB_INTERN_ACTIVE,
+  RB_INTERN_COMMIT,
+  RB_INTERN_CLOSE_CURSOR,
+  RB_INTERN_CONNECTION,
+  RB_INTERN_SQL,
+  RB_INTERN_DIALECT;
+
+static const long FETCH_BATCH_SIZE = 256;
+
+
+/**
+ * This function integrates with the Ruby memory control system to provide for
+ * the allocation of ResultSet objects.
+ *
+ * @param  klass  A reference to the ResultSet Class object.
+ *
+ * @return  A reference to the newly allocated ResultSet object.
+ *
+ */
+static VALUE allocateResultSet(VALUE klass) {
+  ResultSetHandle *results = ALLOC(ResultSetHandle);
+
+  if(results == NULL) {
+    rb_raise(rb_eNoMemError,
+             "Memory allocation failure allocating a result set.");
+  }
+
+  results->statement          = Qnil;
+  results->transaction        = Qnil;
+  results->rows               = 0;
+  results->active             = 0;
+  results->manage_statement   = 0;
+  results->manage_transaction = 0;
+
+  return(Data_Wrap_Struct(klass, resultSetMark, resultSetFree, results));
+}
+
+
+/**
+ * This function provides the initialize method for the ResultSet class.
+ *
+ * @param  self         A reference to the ResultSet object to be initialized.
+ * @param  statement    A reference to the executed Statement the results are
+ *                      fetched from.
+ * @param  transaction  A reference to the Transaction the statement was
+ *                      executed in.
+ *
+ * @return  A reference to the newly initialized ResultSet object.
+ *
+ */
+static VALUE initializeResultSet(VALUE self, VALUE statement,
+                                 VALUE transaction) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  results->statement   = statement;
+  results->transaction = transaction;
+  results->rows        = 0;
+  results->active      = 1;
+
+  return(self);
+}
+
+
+/**
+ * This function provides the statement attribute accessor for the ResultSet
+ * class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to the Statement object for the result set.
+ *
+ */
+static VALUE getResultSetStatement(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+
+  return(results->statement);
+}
+
+
+/**
+ * This function provides the transaction attribute accessor for the ResultSet
+ * class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to the Transaction object for the result set.
+ *
+ */
+static VALUE getResultSetTransaction(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+
+  return(results->transaction);
+}
+
+
+/**
+ * This function provides the row_count attribute accessor for the ResultSet
+ * class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to an Integer containing the number of rows fetched.
+ *
+ */
+static VALUE getResultSetRowCount(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+
+  return(LONG2NUM(results->rows));
+}
+
+
+/**
+ * This function turns an entry fetched from a statement into a numbered Row
+ * object.
+ *
+ * @param  entry     Either an Array of row values or a lazy Row object.
+ * @param  metadata  A reference to the Array of column metadata for the row.
+ * @param  columns   A reference to the Hash of column keys to offsets.
+ * @param  number    The number of the row within its result set.
+ *
+ * @return  A reference to the Row object.
+ *
+ */
+static VALUE toResultSetRow(VALUE entry, VALUE metadata, VALUE columns,
+                            long number) {
+  if(TYPE(entry) == T_ARRAY) {
+    return(rb_row_new(metadata, columns, entry, number));
+  }
+  setRowNumber(entry, number);
+  return(entry);
+}
+
+
+/**
+ * This function provides the body of the each method for the ResultSet
+ * class, fetching rows from the statement in batches and passing them to the
+ * block.
+ *
+ * @param  self  A reference to the ResultSet object.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE yieldResultSetRows(VALUE self) {
+  ResultSetHandle *results = NULL;
+  VALUE           metadata, columns;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  metadata = getStatementMetadata(results->statement);
+  columns  = getStatementColumnIndex(results->statement);
+  while(results->active) {
+    VALUE rows = fetchStatementRows(results->statement, FETCH_BATCH_SIZE,
+                                    results->transaction, 1);
+    long  index;
+
+    for(index = 0; index < RARRAY_LEN(rows) && results->active; index++) {
+      results->rows++;
+      rb_yield(toResultSetRow(rb_ary_entry(rows, index), metadata, columns,
+                              results->rows));
+    }
+    if(RARRAY_LEN(rows) < FETCH_BATCH_SIZE) {
+      closeResultSet(self);
+    }
+  }
+
+  return(Qnil);
+}
+
+
+/**
+ * This function provides the each method for the ResultSet class. The result
+ * set is closed once the rows have been iterated or the block exits early.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE eachResultSetRow(VALUE self) {
+  RETURN_ENUMERATOR(self, 0, 0);
+
+  return(rb_ensure(yieldResultSetRows, self, closeResultSet, self));
+}
+
+
+/**
+ * This function fetches rows from the statement of a result set in batches
+ * and passes the values of each row to the block, either as an Array or as
+ * a Hash of column keys to values. No Row objects are created.
+ *
+ * @param  self    A reference to the ResultSet object.
+ * @param  hashes  1 to pass a Hash for each row, 0 to pass an Array.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE yieldResultSetValues(VALUE self, short hashes) {
+  ResultSetHandle *results = NULL;
+  VALUE           keys     = Qnil;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  if(hashes) {
+    VALUE metadata = getStatementMetadata(results->statement);
+    long  index;
+
+    keys = rb_ary_new2(RARRAY_LEN(metadata));
+    for(index = 0; index < RARRAY_LEN(metadata); index++) {
+      rb_ary_push(keys, rb_ivar_get(rb_ary_entry(metadata, index),
+                                    RB_INTERN_AT_KEY));
+    }
+  }
+  while(results->active) {
+    VALUE rows = fetchStatementRows(results->statement, FETCH_BATCH_SIZE,
+                                    results->transaction, 0);
+    long  index;
+
+    for(index = 0; index < RARRAY_LEN(rows) && results->active; index++) {
+      VALUE values = rb_ary_entry(rows, index);
+
+      results->rows++;
+      if(hashes) {
+        VALUE hash = rb_hash_new();
+        long  column;
+
+        for(column = 0; column < RARRAY_LEN(values); column++) {
+          rb_hash_aset(hash, rb_ary_entry(keys, column),
+                       rb_ary_entry(values, column));
+        }
+        values = hash;
+      }
+      rb_yield(values);
+    }
+    if(RARRAY_LEN(rows) < FETCH_BATCH_SIZE) {
+      closeResultSet(self);
+    }
+  }
+
+  return(Qnil);
+}
+
+
+/**
+ * This function provides the body of the each_array method for the
+ * ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE yieldResultSetArrays(VALUE self) {
+  return(yieldResultSetValues(self, 0));
+}
+
+
+/**
+ * This function provides the body of the each_hash method for the ResultSet
+ * class.
+ *
+ * @param  self  A reference to the ResultSet object.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE yieldResultSetHashes(VALUE self) {
+  return(yieldResultSetValues(self, 1));
+}
+
+
+/**
+ * This function provides the each_array method for the ResultSet class. The
+ * block is passed an Array of the values of each row. The result set is
+ * closed once the rows have been iterated or the block exits early.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE eachResultSetArray(VALUE self) {
+  RETURN_ENUMERATOR(self, 0, 0);
+
+  return(rb_ensure(yieldResultSetArrays, self, closeResultSet, self));
+}
+
+
+/**
+ * This function provides the each_hash method for the ResultSet class. The
+ * block is passed a Hash of the column keys to the values of each row. The
+ * result set is closed once the rows have been iterated or the block exits
+ * early.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE eachResultSetHash(VALUE self) {
+  RETURN_ENUMERATOR(self, 0, 0);
+
+  return(rb_ensure(yieldResultSetHashes, self, closeResultSet, self));
+}
+
+
+/**
+ * This function provides the body of the to_a method for the ResultSet
+ * class, fetching all of the remaining rows of the result set.
+ *
+ * @param  self  A reference to the ResultSet object.
+ *
+ * @return  A reference to an Array of Row objects.
+ *
+ */
+static VALUE collectResultSetRows(VALUE self) {
+  ResultSetHandle *results = NULL;
+  VALUE           metadata, columns,
+                  array = rb_ary_new();
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  metadata = getStatementMetadata(results->statement);
+  columns  = getStatementColumnIndex(results->statement);
+  while(results->active) {
+    VALUE rows = fetchStatementRows(results->statement, FETCH_BATCH_SIZE,
+                                    results->transaction, 1);
+    long  index;
+
+    for(index = 0; index < RARRAY_LEN(rows); index++) {
+      results->rows++;
+      rb_ary_push(array, toResultSetRow(rb_ary_entry(rows, index), metadata,
+                                        columns, results->rows));
+    }
+    if(RARRAY_LEN(rows) < FETCH_BATCH_SIZE) {
+      closeResultSet(self);
+    }
+  }
+
+  return(array);
+}
+
+
+/**
+ * This function provides the to_a method for the ResultSet class. All of the
+ * remaining rows are fetched and the result set is closed.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to an Array of Row objects.
+ *
+ */
+static VALUE resultSetToArray(VALUE self) {
+  return(rb_ensure(collectResultSetRows, self, closeResultSet, self));
+}
+
+
+/**
+ * This function provides the fetch method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to the next Row object for the result set, or nil if
+ *          the result set has been exhausted.
+ *
+ */
+static VALUE fetchResultSetRow(VALUE self) {
+  ResultSetHandle *results    = NULL;
+  StatementHandle *hStatement = NULL;
+  VALUE           rows, row;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  if(!results->active) {
+    return(Qnil);
+  }
+
+  Data_Get_Struct(results->statement, StatementHandle, hStatement);
+  rows = fetchStatementRows(results->statement, 1, results->transaction, 1);
+  if(RARRAY_LEN(rows) == 0) {
+    closeResultSet(self);
+    return(Qnil);
+  }
+
+  results->rows = isCursorStatement(hStatement) ? results->rows + 1 : 1;
+  row = toResultSetRow(rb_ary_entry(rows, 0),
+                       getStatementMetadata(results->statement),
+                       getStatementColumnIndex(results->statement),
+                       results->rows);
+  if(!isCursorStatement(hStatement)) {
+    closeResultSet(self);
+  }
+
+  return(row);
+}
+
+
+/**
+ * This function provides the close method for the ResultSet class. The
+ * statement cursor is closed and, where the result set manages them, the
+ * statement is released and the transaction committed.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE closeResultSet(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  if(!results->active) {
+    return(Qnil);
+  }
+
+  results->active = 0;
+  rb_funcall(results->statement, RB_INTERN_CLOSE_CURSOR, 0);
+  if(results->manage_statement) {
+    releaseStatement(results->statement);
+  }
+  if(results->manage_transaction &&
+     rb_funcall(results->transaction, RB_INTERN_ACTIVE, 0) == Qtrue) {
+    rb_funcall(results->transaction, RB_INTERN_COMMIT, 0);
+  }
+
+  return(Qnil);
+}
+
+
+/**
+ * This function provides the connection method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to the Connection object for the result set.
+ *
+ */
+static VALUE getResultSetConnection(VALUE self) {
+  return(rb_funcall(getResultSetStatement(self), RB_INTERN_CONNECTION, 0));
+}
+
+
+/**
+ * This function provides the sql method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to a String containing the SQL for the result set.
+ *
+ */
+static VALUE getResultSetSQL(VALUE self) {
+  return(rb_funcall(getResultSetStatement(self), RB_INTERN_SQL, 0));
+}
+
+
+/**
+ * This function provides the dialect method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to an Integer containing the SQL dialect.
+ *
+ */
+static VALUE getResultSetDialect(VALUE self) {
+  return(rb_funcall(getResultSetStatement(self), RB_INTERN_DIALECT, 0));
+}
+
+
+/**
+ * This function fetches a metadata attribute for a column of a result set.
+ *
+ * @param  self       A reference to the ResultSet object.
+ * @param  index      The offset of the column.
+ * @param  attribute  The ID of the metadata attribute to be fetched.
+ *
+ * @return  A reference to the attribute value, or nil if the offset is out of
+ *          range.
+ *
+ */
+static VALUE getColumnAttribute(VALUE self, VALUE index, ID attribute) {
+  VALUE metadata = getStatementMetadata(getResultSetStatement(self));
+  long  offset   = NUM2LONG(index);
+
+  if(offset >= 0 && offset < RARRAY_LEN(metadata)) {
+    return(rb_ivar_get(rb_ary_entry(metadata, offset), attribute));
+  }
+
+  return(Qnil);
+}
+
+
+/**
+ * This function provides the column_name method for the ResultSet class.
+ *
+ * @param  self   A reference to the ResultSet object to call the method on.
+ * @param  index  The offset of the column.
+ *
+ * @return  A reference to a String containing the column name.
+ *
+ */
+static VALUE getResultSetColumnName(VALUE self, VALUE index) {
+  return(getColumnAttribute(self, index, RB_INTERN_AT_NAME));
+}
+
+
+/**
+ * This function provides the column_alias method for the ResultSet class.
+ *
+ * @param  self   A reference to the ResultSet object to call the method on.
+ * @param  index  The offset of the column.
+ *
+ * @return  A reference to a String containing the column alias.
+ *
+ */
+static VALUE getResultSetColumnAlias(VALUE self, VALUE index) {
+  return(getColumnAttribute(self, index, RB_INTERN_AT_ALIAS));
+}
+
+
+/**
+ * This function provides the column_scale method for the ResultSet class.
+ *
+ * @param  self   A reference to the ResultSet object to call the method on.
+ * @param  index  The offset of the column.
+ *
+ * @return  A reference to an Integer containing the column scale.
+ *
+ */
+static VALUE getResultSetColumnScale(VALUE self, VALUE index) {
+  return(getColumnAttribute(self, index, RB_INTERN_AT_SCALE));
+}
+
+
+/**
+ * This function provides the column_table method for the ResultSet class.
+ *
+ * @param  self   A reference to the ResultSet object to call the method on.
+ * @param  index  The offset of the column.
+ *
+ * @return  A reference to a String containing the column table name.
+ *
+ */
+static VALUE getResultSetColumnTable(VALUE self, VALUE index) {
+  return(getColumnAttribute(self, index, RB_INTERN_AT_RELATION));
+}
+
+
+/**
+ * This function provides the get_base_type method for the ResultSet class.
+ *
+ * @param  self   A reference to the ResultSet object to call the method on.
+ * @param  index  The offset of the column.
+ *
+ * @return  A reference to a Symbol containing the column base type.
+ *
+ */
+static VALUE getResultSetColumnBaseType(VALUE self, VALUE index) {
+  return(getColumnAttribute(self, index, RB_INTERN_AT_TYPE));
+}
+
+
+/**
+ * This function provides the column_count method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  A reference to an Integer containing the column count.
+ *
+ */
+static VALUE getResultSetColumnCount(VALUE self) {
+  VALUE metadata = getStatementMetadata(getResultSetStatement(self));
+
+  return(LONG2FIX(RARRAY_LEN(metadata)));
+}
+
+
+/**
+ * This function provides the active? method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  Qtrue if the result set has rows left to fetch, Qfalse otherwise.
+ *
+ */
+static VALUE getResultSetActive(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+
+  return(results->active ? Qtrue : Qfalse);
+}
+
+
+/**
+ * This function provides the exhausted? method for the ResultSet class.
+ *
+ * @param  self  A reference to the ResultSet object to call the method on.
+ *
+ * @return  Qtrue if the result set has been closed, Qfalse otherwise.
+ *
+ */
+static VALUE getResultSetExhausted(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+
+  return(results->active ? Qfalse : Qtrue);
+}
+
+
+/**
+ * This function provides a programmatic means of creating a ResultSet object.
+ *
+ * @param  statement    A reference to the executed Statement object.
+ * @param  transaction  A reference to the Transaction the statement was
+ *                      executed in.
+ *
+ * @return  A reference to the newly created ResultSet object.
+ *
+ */
+VALUE rb_result_set_new(VALUE statement, VALUE transaction) {
+  VALUE results = allocateResultSet(cResultSet);
+
+  initializeResultSet(results, statement, transaction);
+
+  return(results);
+}
+
+
+/**
+ * This function checks whether an object is an active ResultSet.
+ *
+ * @param  object  A reference to the object to be checked.
+ *
+ * @return  1 if the object is an active ResultSet, 0 otherwise.
+ *
+ */
+short isActiveResultSet(VALUE object) {
+  ResultSetHandle *results = NULL;
+
+  if(rb_obj_is_kind_of(object, cResultSet) != Qtrue) {
+    return(0);
+  }
+  Data_Get_Struct(object, ResultSetHandle, results);
+
+  return(results->active);
+}
+
+
+/**
+ * This function makes a result set responsible for closing its statement
+ * when the result set is closed.
+ *
+ * @param  self  A reference to the ResultSet object.
+ *
+ */
+void manageResultSetStatement(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  results->manage_statement = 1;
+}
+
+
+/**
+ * This function makes a result set responsible for committing its
+ * transaction when the result set is closed.
+ *
+ * @param  self  A reference to the ResultSet object.
+ *
+ */
+void manageResultSetTransaction(VALUE self) {
+  ResultSetHandle *results = NULL;
+
+  Data_Get_Struct(self, ResultSetHandle, results);
+  results->manage_transaction = 1;
+}
+
+
+/**
+ * This function integrates with the Ruby garbage collector to mark the
+ * objects referenced by a ResultSet object.
+ *
+ * @param  handle  A pointer to the ResultSetHandle structure for the object.
+ *
+ */
+static void resultSetMark(void *handle) {
+  ResultSetHandle *results = (ResultSetHandle *)handle;
+
+  rb_gc_mark(results->statement);
+  rb_gc_mark(results->transaction);
+}
+
+
+/**
+ * This function integrates with the Ruby garbage collector to release the
+ * resources associated with a ResultSet object that is being collected.
+ *
+ * @param  handle  A pointer to the ResultSetHandle structure for the object.
+ *
+ */
+static void resultSetFree(void *handle) {
+  if(handle != NULL) {
+    free(handle);
+  }
+}
+
+
+/**
+ * This function initializes the ResultSet class within the Ruby environment.
+ *
+ * @param  module  A reference to the module to create the class within.
+ *
+ */
+void Init_ResultSet(VALUE module) {
+  RB_INTERN_AT_NAME = rb_intern("@name");
+  RB_INTERN_AT_ALIAS = rb_intern("@alias");
+  RB_INTERN_AT_TYPE = rb_intern("@type");
+  RB_INTERN_AT_SCALE = rb_intern("@scale");
+  RB_INTERN_AT_RELATION = rb_intern("@relation");
+  RB_INTERN_AT_KEY = rb_intern("@key");
+  RB_INTERN_ACTIVE = rb_intern("active?");
+  RB_INTERN_COMMIT = rb_intern("commit");
+  RB_INTERN_CLOSE_CURSOR = rb_intern("close_cursor");
+  RB_INTERN_CONNECTION = rb_intern("connection");
+  RB_INTERN_SQL = rb_intern("sql");
+  RB_INTERN_DIALECT = rb_intern("dialect");
+
+  cResultSet = rb_define_class_under(module, "ResultSet", rb_cObject);
+  rb_include_module(cResultSet, rb_mEnumerable);
+  rb_define_alloc_func(cResultSet, allocateResultSet);
+  rb_define_method(cResultSet, "initialize", initializeResultSet, 2);
+  rb_define_method(cResultSet, "initialize_copy", forbidObjectCopy, 1);
+  rb_define_method(cResultSet, "statement", getResultSetStatement, 0);
+  rb_define_method(cResultSet, "transaction", getResultSetTransaction, 0);
+  rb_define_method(cResultSet, "row_count", getResultSetRowCount, 0);
+  rb_define_method(cResultSet, "each", eachResultSetRow, 0);
+  rb_define_method(cResultSet, "each_array", eachResultSetArray, 0);
+  rb_define_method(cResultSet, "each_hash", eachResultSetHash, 0);
+  rb_define_method(cResultSet, "to_a", resultSetToArray, 0);
+  rb_define_method(cResultSet, "fetch", fetchResultSetRow, 0);
+  rb_define_method(cResultSet, "close", closeResultSet, 0);
+  rb_define_method(cResultSet, "connection", getResultSetConnection, 0);
+  rb_define_method(cResultSet, "sql", getResultSetSQL, 0);
+  rb_define_method(cResultSet, "dialect", getResultSetDialect, 0);
+  rb_define_method(cResultSet, "column_name", getResultSetColumnName, 1);
+  rb_define_method(cResultSet, "column_alias", getResultSetColumnAlias, 1);
+  rb_define_method(cResultSet, "column_scale", getResultSetColumnScale, 1);
+  rb_define_method(cResultSet, "column_table", getResultSetColumnTable, 1);
+  rb_define_method(cResultSet, "get_base_type", getResultSetColumnBaseType, 1);
+  rb_define_method(cResultSet, "column_count", getResultSetColumnCount, 0);
+  rb_define_method(cResultSet, "active?", getResultSetActive, 0);
+  rb_define_method(cResultSet, "exhausted?", getResultSetExhausted, 0);
+
+  rb_define_alias(cResultSet, "all", "to_a");
+
+  rb_define_const(cResultSet, "FETCH_BATCH_SIZE", LONG2FIX(FETCH_BATCH_SIZE));
+}
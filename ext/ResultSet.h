@@ -0,0 +1,33 @@
+/*------------------------------------------------------------------------------
+ * ResultSet.h
+ *----------------------------------------------------------------------------*/
+#ifndef FIRERUBY_RESULT_SET_H
+#define FIRERUBY_RESULT_SET_H
+
+/* Includes. */
+   #ifndef RUBY_H_INCLUDED
+      #include "ruby.h"
+      #define RUBY_H_INCLUDED
+   #endif
+
+/* Type definitions. */
+typedef struct {
+  VALUE statement,
+        transaction;
+  long  rows;
+  short active,
+        manage_statement,
+        manage_transaction;
+} ResultSetHandle;
+
+/* Data elements. */
+extern VALUE cResultSet;
+
+/* Function prototypes. */
+VALUE rb_result_set_new(VALUE, VALUE);
+short isActiveResultSet(VALUE);
+void manageResultSetStatement(VALUE);
+void manageResultSetTransaction(VALUE);
+void Init_ResultSet(VALUE);
+
+#endif /* FIRERUBY_RESULT_SET_H */
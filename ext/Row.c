@@ -0,0 +1,1122 @@
+/*------------------------------------------------------------------------------
+ * Row.c
+ *----------------------------------------------------------------------------*/
+
+/* Includes. */
+#include "Row.h"
+#include "TypeMap.h"
+
+/* Function prototypes. */
+static VALUE allocateRow(VALUE);
+static VALUE initializeRow(VALUE, VALUE, VALUE, VALUE);
+static VALUE copyRow(VALUE, VALUE);
+static VALUE getRowNumber(VALUE);
+static VALUE getRowColumnCount(VALUE);
+static VALUE getRowColumnName(VALUE, VALUE);
+static VALUE getRowColumnAlias(VALUE, VALUE);
+static VALUE getRowColumnScale(VALUE, VALUE);
+static VALUE getRowColumnBaseType(VALUE, VALUE);
+static VALUE eachRowValue(VALUE);
+static VALUE eachRowKey(VALUE);
+static VALUE eachRowValueOnly(VALUE);
+static VALUE getRowValue(VALUE, VALUE);
+static VALUE fetchRowValue(int, VALUE *, VALUE);
+static VALUE rowHasKey(VALUE, VALUE);
+static VALUE rowHasColumn(VALUE, VALUE);
+static VALUE rowHasAlias(VALUE, VALUE);
+static VALUE rowHasValue(VALUE, VALUE);
+static VALUE getRowKeys(VALUE);
+static VALUE getRowNames(VALUE);
+static VALUE getRowAliases(VALUE);
+static VALUE getRowValues(VALUE);
+static VALUE selectRowEntries(VALUE);
+static VALUE rowToArray(VALUE);
+static VALUE rowToHash(VALUE);
+static VALUE rowValuesAt(int, VALUE *, VALUE);
+static void rowMark(void *);
+static void rowFree(void *);
+static void rowLayoutFree(void *);
+static void releaseRowData(RowHandle *);
+static VALUE getColumnValue(RowHandle *, long);
+static void loadColumnValues(RowHandle *);
+
+/* Globals. */
+VALUE cRow;
+
+/* The anonymous class of row layouts, kept out of sight of Ruby code. */
+static VALUE cRowLayout;
+
+static ID
+  RB_INTERN_AT_NAME,
+  RB_INTERN_AT_ALIAS,
+  RB_INTERN_AT_KEY,
+  RB_INTERN_AT_TYPE,
+  RB_INTERN_AT_SCALE;
+
+/* The offset recorded for a lazy row column that holds no undecoded data. */
+#define ROW_DECODED -1
+
+
+/**
+ * This function integrates with the Ruby memory control system to provide for
+ * the allocation of Row objects.
+ *
+ * @param  klass  A reference to the Row Class object.
+ *
+ * @return  A reference to the newly allocated Row object.
+ *
+ */
+static VALUE allocateRow(VALUE klass) {
+  RowHandle *row = ALLOC(RowHandle);
+
+  if(row == NULL) {
+    rb_raise(rb_eNoMemError, "Memory allocation failure allocating a row.");
+  }
+
+  row->metadata    = Qnil;
+  row->columns     = Qnil;
+  row->values      = Qnil;
+  row->layout      = Qnil;
+  row->connection  = Qnil;
+  row->transaction = Qnil;
+  row->number      = 0;
+  row->offsets     = NULL;
+  row->remaining   = 0;
+  row->data        = NULL;
+  row->intern      = 0;
+  row->inlining    = 0;
+  row->trim        = 0;
+  row->decimal     = 0;
+
+  return(Data_Wrap_Struct(klass, rowMark, rowFree, row));
+}
+
+
+/**
+ * This function builds a Hash that maps the key of each column in a metadata
+ * Array to the offset of the column. Where several columns share the same key
+ * the first column wins.
+ *
+ * @param  metadata  A reference to an Array of column metadata objects.
+ *
+ * @return  A reference to a frozen Hash of column keys to column offsets.
+ *
+ */
+VALUE createColumnIndex(VALUE metadata) {
+  VALUE columns = rb_hash_new();
+  long  index;
+
+  for(index = 0; index < RARRAY_LEN(metadata); index++) {
+    VALUE key = rb_ivar_get(rb_ary_entry(metadata, index), RB_INTERN_AT_KEY);
+
+    if(rb_hash_lookup2(columns, key, Qundef) == Qundef) {
+      rb_hash_aset(columns, key, LONG2FIX(index));
+    }
+  }
+  rb_obj_freeze(columns);
+
+  return(columns);
+}
+
+
+/**
+ * This function provides the initialize method for the Row class.
+ *
+ * @param  self      A reference to the Row object to be initialized.
+ * @param  metadata  A reference to an Array of column metadata objects.
+ * @param  data      A reference to an Array of the row values.
+ * @param  number    The number of the row within its result set.
+ *
+ * @return  A reference to the newly initialized Row object.
+ *
+ */
+static VALUE initializeRow(VALUE self, VALUE metadata, VALUE data,
+                           VALUE number) {
+  RowHandle *row = NULL;
+
+  Check_Type(metadata, T_ARRAY);
+  Check_Type(data, T_ARRAY);
+  Data_Get_Struct(self, RowHandle, row);
+  row->metadata = metadata;
+  row->columns  = createColumnIndex(metadata);
+  row->values   = data;
+  row->number   = NUM2LONG(number);
+
+  return(self);
+}
+
+
+/**
+ * This function provides the initialize_copy method for the Row class.
+ *
+ * @param  copy      A reference to the Row object being initialized.
+ * @param  original  A reference to the Row object being copied.
+ *
+ * @return  A reference to the copy.
+ *
+ */
+static VALUE copyRow(VALUE copy, VALUE original) {
+  RowHandle *target = NULL,
+            *source = NULL;
+
+  Data_Get_Struct(copy, RowHandle, target);
+  Data_Get_Struct(original, RowHandle, source);
+  loadColumnValues(source);
+  target->metadata = source->metadata;
+  target->columns  = source->columns;
+  target->values   = rb_ary_dup(source->values);
+  target->number   = source->number;
+
+  return(copy);
+}
+
+
+/**
+ * This function releases the raw column data held by a lazy row once all of
+ * its columns have been decoded.
+ *
+ * @param  row  A pointer to the RowHandle for the row.
+ *
+ */
+static void releaseRowData(RowHandle *row) {
+  if(row->data != NULL) {
+    free(row->data);
+    row->data = NULL;
+  }
+  if(row->offsets != NULL) {
+    free(row->offsets);
+    row->offsets = NULL;
+  }
+  row->remaining   = 0;
+  row->layout      = Qnil;
+  row->connection  = Qnil;
+  row->transaction = Qnil;
+}
+
+
+/**
+ * This function fetches the value of a column from a row. Columns of a lazy
+ * row are decoded from the raw column data on first access and the result is
+ * kept for later calls.
+ *
+ * @param  row    A pointer to the RowHandle for the row.
+ * @param  index  The offset of the column.
+ *
+ * @return  A reference to the column value, nil if the offset is out of
+ *          range.
+ *
+ */
+static VALUE getColumnValue(RowHandle *row, long index) {
+  RowLayout *layout = NULL;
+  XSQLVAR   entry;
+  short     indicator = 0;
+  VALUE     value;
+
+  if(row->offsets == NULL || index < 0 || index >= RARRAY_LEN(row->values) ||
+     row->offsets[index] == ROW_DECODED) {
+    return(rb_ary_entry(row->values, index));
+  }
+
+  Data_Get_Struct(row->layout, RowLayout, layout);
+  entry         = layout->columns[index];
+  entry.sqldata = &row->data[row->offsets[index]];
+  entry.sqlind  = &indicator;
+  value = toValue(&entry, layout->encodings[index], row->intern, row->trim,
+                  row->decimal, row->inlining, row->connection,
+                  row->transaction);
+  rb_ary_store(row->values, index, value);
+  row->offsets[index] = ROW_DECODED;
+  if(--row->remaining == 0) {
+    releaseRowData(row);
+  }
+
+  return(value);
+}
+
+
+/**
+ * This function decodes any columns of a lazy row that have not yet been
+ * accessed.
+ *
+ * @param  row  A pointer to the RowHandle for the row.
+ *
+ */
+static void loadColumnValues(RowHandle *row) {
+  long index;
+
+  for(index = 0; row->offsets != NULL && index < RARRAY_LEN(row->values);
+      index++) {
+    getColumnValue(row, index);
+  }
+}
+
+
+/**
+ * This function resolves a column identifier to a column offset.
+ *
+ * @param  row  A pointer to the RowHandle for the row.
+ * @param  key  Either a String containing a column key or an Integer offset,
+ *              which may be negative to count back from the last column.
+ *
+ * @return  The offset of the column, or -1 if a key does not match a column.
+ *
+ */
+static long findColumnIndex(RowHandle *row, VALUE key) {
+  long index;
+
+  if(TYPE(key) == T_STRING) {
+    VALUE offset = rb_hash_lookup2(row->columns, key, Qnil);
+
+    return(offset == Qnil ? -1 : FIX2LONG(offset));
+  }
+
+  index = NUM2LONG(key);
+  return(index < 0 ? RARRAY_LEN(row->values) + index : index);
+}
+
+
+/**
+ * This function resolves a column identifier to a column offset, raising an
+ * IndexError if the identifier does not match a column.
+ *
+ * @param  row  A pointer to the RowHandle for the row.
+ * @param  key  The column identifier to resolve.
+ *
+ * @return  The offset of the column.
+ *
+ */
+static long getColumnIndex(RowHandle *row, VALUE key) {
+  long index = findColumnIndex(row, key);
+
+  if(index == -1 && TYPE(key) == T_STRING) {
+    rb_raise(rb_eIndexError, "Column identifier %s not found in row.",
+             StringValueCStr(key));
+  }
+
+  return(index);
+}
+
+
+/**
+ * This function fetches the metadata for a column of a row.
+ *
+ * @param  self  A reference to the Row object.
+ * @param  key   The identifier of the column.
+ *
+ * @return  A reference to the column metadata object.
+ *
+ */
+static VALUE getRowColumn(VALUE self, VALUE key) {
+  RowHandle *row   = NULL;
+  VALUE     column = Qnil;
+
+  Data_Get_Struct(self, RowHandle, row);
+  column = rb_ary_entry(row->metadata, getColumnIndex(row, key));
+  if(column == Qnil) {
+    rb_raise(rb_eIndexError, "Column identifier %ld not found in row.",
+             NUM2LONG(key));
+  }
+
+  return(column);
+}
+
+
+/**
+ * This function fetches the value of a column from a row, returning nil when
+ * the column does not exist.
+ *
+ * @param  row  A pointer to the RowHandle for the row.
+ * @param  key  The identifier of the column.
+ *
+ * @return  A reference to the column value or nil.
+ *
+ */
+static VALUE getSoftValue(RowHandle *row, VALUE key) {
+  long index = findColumnIndex(row, key);
+
+  if(index == -1 && TYPE(key) == T_STRING) {
+    return(Qnil);
+  }
+
+  return(getColumnValue(row, index));
+}
+
+
+/**
+ * This function provides the number attribute accessor for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Integer containing the row number.
+ *
+ */
+static VALUE getRowNumber(VALUE self) {
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+
+  return(LONG2NUM(row->number));
+}
+
+
+/**
+ * This function provides the column_count method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Integer containing the row column count.
+ *
+ */
+static VALUE getRowColumnCount(VALUE self) {
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+
+  return(LONG2FIX(RARRAY_LEN(row->metadata)));
+}
+
+
+/**
+ * This function provides the column_name method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  index  The identifier of the column to fetch the name of.
+ *
+ * @return  A reference to a String containing the column name.
+ *
+ */
+static VALUE getRowColumnName(VALUE self, VALUE index) {
+  return(rb_ivar_get(getRowColumn(self, index), RB_INTERN_AT_NAME));
+}
+
+
+/**
+ * This function provides the column_alias method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  index  The identifier of the column to fetch the alias of.
+ *
+ * @return  A reference to a String containing the column alias.
+ *
+ */
+static VALUE getRowColumnAlias(VALUE self, VALUE index) {
+  return(rb_ivar_get(getRowColumn(self, index), RB_INTERN_AT_ALIAS));
+}
+
+
+/**
+ * This function provides the column_scale method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  index  The identifier of the column to fetch the scale of.
+ *
+ * @return  A reference to an Integer containing the column scale.
+ *
+ */
+static VALUE getRowColumnScale(VALUE self, VALUE index) {
+  return(rb_ivar_get(getRowColumn(self, index), RB_INTERN_AT_SCALE));
+}
+
+
+/**
+ * This function provides the get_base_type method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  index  The identifier of the column to fetch the type of.
+ *
+ * @return  A reference to a Symbol containing the column base type.
+ *
+ */
+static VALUE getRowColumnBaseType(VALUE self, VALUE index) {
+  return(rb_ivar_get(getRowColumn(self, index), RB_INTERN_AT_TYPE));
+}
+
+
+/**
+ * This function provides the each method for the Row class. The block is
+ * passed the key and the value of each column in turn.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to the Row object.
+ *
+ */
+static VALUE eachRowValue(VALUE self) {
+  RowHandle *row = NULL;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  if(rb_block_given_p()) {
+    for(index = 0; index < RARRAY_LEN(row->metadata); index++) {
+      VALUE column = rb_ary_entry(row->metadata, index);
+
+      rb_yield_values(2, rb_ivar_get(column, RB_INTERN_AT_KEY),
+                      getColumnValue(row, index));
+    }
+  }
+
+  return(self);
+}
+
+
+/**
+ * This function provides the each_key method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to the Row object.
+ *
+ */
+static VALUE eachRowKey(VALUE self) {
+  RowHandle *row = NULL;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  if(rb_block_given_p()) {
+    for(index = 0; index < RARRAY_LEN(row->metadata); index++) {
+      rb_yield(rb_ivar_get(rb_ary_entry(row->metadata, index),
+                           RB_INTERN_AT_KEY));
+    }
+  }
+
+  return(self);
+}
+
+
+/**
+ * This function provides the each_value method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to the Row object.
+ *
+ */
+static VALUE eachRowValueOnly(VALUE self) {
+  RowHandle *row = NULL;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  if(rb_block_given_p()) {
+    for(index = 0; index < RARRAY_LEN(row->values); index++) {
+      rb_yield(getColumnValue(row, index));
+    }
+  }
+
+  return(self);
+}
+
+
+/**
+ * This function provides the [] method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  index  Either a String containing a column key or an Integer
+ *                offset for the column.
+ *
+ * @return  A reference to the column value.
+ *
+ */
+static VALUE getRowValue(VALUE self, VALUE index) {
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+
+  return(getColumnValue(row, getColumnIndex(row, index)));
+}
+
+
+/**
+ * This function provides the fetch method for the Row class, modelled on the
+ * Hash#fetch method.
+ *
+ * @param  argc  A count of the arguments passed to the method.
+ * @param  argv  A pointer to the arguments passed to the method.
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to the column value, the default value or the result
+ *          of the block.
+ *
+ */
+static VALUE fetchRowValue(int argc, VALUE *argv, VALUE self) {
+  RowHandle *row = NULL;
+  VALUE     key, alternative = Qnil, value;
+
+  rb_scan_args(argc, argv, "11", &key, &alternative);
+  Data_Get_Struct(self, RowHandle, row);
+  value = getSoftValue(row, key);
+  if(RTEST(value)) {
+    return(value);
+  }
+  if(RTEST(alternative)) {
+    return(alternative);
+  }
+  if(rb_block_given_p()) {
+    return(rb_yield(key));
+  }
+
+  key = rb_obj_as_string(key);
+  rb_raise(rb_eIndexError, "Column identifier %s not found in row.",
+           StringValueCStr(key));
+  return(Qnil);
+}
+
+
+/**
+ * This function checks whether any column of a row has a given value for one
+ * of its metadata attributes.
+ *
+ * @param  self       A reference to the Row object.
+ * @param  attribute  The ID of the metadata attribute to be checked.
+ * @param  value      The value to look for.
+ *
+ * @return  Qtrue if a column matches, Qfalse otherwise.
+ *
+ */
+static VALUE rowHasAttribute(VALUE self, ID attribute, VALUE value) {
+  RowHandle *row = NULL;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  for(index = 0; index < RARRAY_LEN(row->metadata); index++) {
+    VALUE column = rb_ary_entry(row->metadata, index);
+
+    if(rb_equal(rb_ivar_get(column, attribute), value) == Qtrue) {
+      return(Qtrue);
+    }
+  }
+
+  return(Qfalse);
+}
+
+
+/**
+ * This function provides the has_key? method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ * @param  key   The column key to check for.
+ *
+ * @return  Qtrue if the row has a column with the key, Qfalse otherwise.
+ *
+ */
+static VALUE rowHasKey(VALUE self, VALUE key) {
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+  if(TYPE(key) != T_STRING) {
+    return(Qfalse);
+  }
+
+  return(rb_hash_lookup2(row->columns, key, Qundef) == Qundef ? Qfalse : Qtrue);
+}
+
+
+/**
+ * This function provides the has_column? method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ * @param  name  The column name to check for.
+ *
+ * @return  Qtrue if the row has a column with the name, Qfalse otherwise.
+ *
+ */
+static VALUE rowHasColumn(VALUE self, VALUE name) {
+  return(rowHasAttribute(self, RB_INTERN_AT_NAME, name));
+}
+
+
+/**
+ * This function provides the has_alias? method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  alias  The column alias to check for.
+ *
+ * @return  Qtrue if the row has a column with the alias, Qfalse otherwise.
+ *
+ */
+static VALUE rowHasAlias(VALUE self, VALUE alias) {
+  return(rowHasAttribute(self, RB_INTERN_AT_ALIAS, alias));
+}
+
+
+/**
+ * This function provides the has_value? method for the Row class.
+ *
+ * @param  self   A reference to the Row object to call the method on.
+ * @param  value  The value to check for.
+ *
+ * @return  Qtrue if a column of the row holds the value, Qfalse otherwise.
+ *
+ */
+static VALUE rowHasValue(VALUE self, VALUE value) {
+  RowHandle *row = NULL;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  for(index = 0; index < RARRAY_LEN(row->values); index++) {
+    if(rb_equal(getColumnValue(row, index), value) == Qtrue) {
+      return(Qtrue);
+    }
+  }
+
+  return(Qfalse);
+}
+
+
+/**
+ * This function collects a metadata attribute for all of the columns of a
+ * row.
+ *
+ * @param  self       A reference to the Row object.
+ * @param  attribute  The ID of the metadata attribute to be collected.
+ *
+ * @return  A reference to an Array of the attribute values.
+ *
+ */
+static VALUE collectRowAttribute(VALUE self, ID attribute) {
+  RowHandle *row = NULL;
+  VALUE     array;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  array = rb_ary_new2(RARRAY_LEN(row->metadata));
+  for(index = 0; index < RARRAY_LEN(row->metadata); index++) {
+    rb_ary_push(array, rb_ivar_get(rb_ary_entry(row->metadata, index),
+                                   attribute));
+  }
+
+  return(array);
+}
+
+
+/**
+ * This function provides the keys method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Array of the column keys.
+ *
+ */
+static VALUE getRowKeys(VALUE self) {
+  return(collectRowAttribute(self, RB_INTERN_AT_KEY));
+}
+
+
+/**
+ * This function provides the names method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Array of the column names.
+ *
+ */
+static VALUE getRowNames(VALUE self) {
+  return(collectRowAttribute(self, RB_INTERN_AT_NAME));
+}
+
+
+/**
+ * This function provides the aliases method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Array of the column aliases.
+ *
+ */
+static VALUE getRowAliases(VALUE self) {
+  return(collectRowAttribute(self, RB_INTERN_AT_ALIAS));
+}
+
+
+/**
+ * This function provides the values method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to the Array of the row values.
+ *
+ */
+static VALUE getRowValues(VALUE self) {
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+  loadColumnValues(row);
+
+  return(row->values);
+}
+
+
+/**
+ * This function collects key/value pairs for the columns of a row.
+ *
+ * @param  self     A reference to the Row object.
+ * @param  filter   Non-zero if only the pairs that the block returns true for
+ *                  are to be collected.
+ *
+ * @return  A reference to an Array of key/value Arrays.
+ *
+ */
+static VALUE collectRowEntries(VALUE self, int filter) {
+  RowHandle *row = NULL;
+  VALUE     array;
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  array = rb_ary_new2(RARRAY_LEN(row->metadata));
+  for(index = 0; index < RARRAY_LEN(row->metadata); index++) {
+    VALUE key   = rb_ivar_get(rb_ary_entry(row->metadata, index),
+                              RB_INTERN_AT_KEY),
+          value = getColumnValue(row, index);
+
+    if(!filter || RTEST(rb_yield_values(2, key, value))) {
+      rb_ary_push(array, rb_assoc_new(key, value));
+    }
+  }
+
+  return(array);
+}
+
+
+/**
+ * This function provides the select method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Array of the key/value pairs that the block
+ *          returned true for.
+ *
+ */
+static VALUE selectRowEntries(VALUE self) {
+  if(!rb_block_given_p()) {
+    rb_raise(rb_eStandardError, "No block specified in call to Row#select.");
+  }
+
+  return(collectRowEntries(self, 1));
+}
+
+
+/**
+ * This function provides the to_a method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Array of the row key/value pairs.
+ *
+ */
+static VALUE rowToArray(VALUE self) {
+  return(collectRowEntries(self, 0));
+}
+
+
+/**
+ * This function provides the to_hash method for the Row class.
+ *
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to a Hash of the row column keys to values.
+ *
+ */
+static VALUE rowToHash(VALUE self) {
+  RowHandle *row = NULL;
+  VALUE     hash = rb_hash_new();
+  long      index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  for(index = 0; index < RARRAY_LEN(row->metadata); index++) {
+    rb_hash_aset(hash, rb_ivar_get(rb_ary_entry(row->metadata, index),
+                                   RB_INTERN_AT_KEY),
+                 getColumnValue(row, index));
+  }
+
+  return(hash);
+}
+
+
+/**
+ * This function provides the values_at method for the Row class.
+ *
+ * @param  argc  A count of the column identifiers passed to the method.
+ * @param  argv  A pointer to the column identifiers passed to the method.
+ * @param  self  A reference to the Row object to call the method on.
+ *
+ * @return  A reference to an Array of the values for the columns, with nil
+ *          for any column that does not exist.
+ *
+ */
+static VALUE rowValuesAt(int argc, VALUE *argv, VALUE self) {
+  RowHandle *row = NULL;
+  VALUE     array = rb_ary_new2(argc);
+  int       index;
+
+  Data_Get_Struct(self, RowHandle, row);
+  for(index = 0; index < argc; index++) {
+    rb_ary_push(array, getSoftValue(row, argv[index]));
+  }
+
+  return(array);
+}
+
+
+/**
+ * This function provides a programmatic means of creating a Row object.
+ *
+ * @param  metadata  A reference to the Array of column metadata for the row.
+ * @param  columns   A reference to the Hash of column keys to offsets for the
+ *                   metadata.
+ * @param  values    A reference to the Array of row values.
+ * @param  number    The number of the row within its result set.
+ *
+ * @return  A reference to the newly created Row object.
+ *
+ */
+VALUE rb_row_new(VALUE metadata, VALUE columns, VALUE values, long number) {
+  VALUE     self = allocateRow(cRow);
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+  row->metadata = metadata;
+  row->columns  = columns;
+  row->values   = values;
+  row->number   = number;
+
+  return(self);
+}
+
+
+/**
+ * This function creates a Row object that holds a copy of the raw data for
+ * the row currently held in a statement output area. Column values are only
+ * decoded, and blobs opened, when they are first accessed.
+ *
+ * @param  metadata     A reference to the Array of column metadata for the
+ *                      row.
+ * @param  columns      A reference to the Hash of column keys to offsets for
+ *                      the metadata.
+ * @param  layout       A reference to the row layout for the statement, as
+ *                      created by rb_row_layout_new.
+ * @param  output       A pointer to the statement output area holding the
+ *                      row.
+ * @param  connection   A reference to the connection the row was fetched on.
+ * @param  transaction  A reference to the transaction the row was fetched in.
+ * @param  intern       1 if text values are to be returned as frozen,
+ *                      interned Strings.
+ * @param  trim         1 if the blanks padding CHAR values are to be removed.
+ * @param  decimal      The DECIMAL_AS_* value for scaled values.
+ * @param  inlining     The size in bytes up to which blobs are returned as
+ *                      Strings, 0 for no inlining.
+ *
+ * @return  A reference to the newly created Row object, with a row number of
+ *          zero.
+ *
+ */
+VALUE rb_lazy_row_new(VALUE metadata, VALUE columns, VALUE layout,
+                      XSQLDA *output, VALUE connection, VALUE transaction,
+                      short intern, short trim, short decimal,
+                      long inlining) {
+  VALUE     self = rb_row_new(metadata, columns, rb_ary_new2(output->sqld), 0);
+  RowHandle *row = NULL;
+  XSQLVAR   *entry = output->sqlvar;
+  long      index,
+            size = 0;
+
+  Data_Get_Struct(self, RowHandle, row);
+  row->offsets = ALLOC_N(long, output->sqld);
+  for(index = 0; index < output->sqld; index++, entry++) {
+    rb_ary_store(row->values, index, Qnil);
+    if((entry->sqltype & 1) && (*entry->sqlind < 0)) {
+      row->offsets[index] = ROW_DECODED;
+    } else {
+      short length = entry->sqllen;
+
+      if((entry->sqltype & ~1) == SQL_VARYING) {
+        memcpy(&length, entry->sqldata, 2);
+        length += 2;
+      }
+      /* Keep each value aligned for the type it holds. */
+      row->offsets[index] = (size + 7) & ~7;
+      size = row->offsets[index] + length;
+      row->remaining++;
+    }
+  }
+
+  if(row->remaining == 0) {
+    releaseRowData(row);
+    return(self);
+  }
+
+  row->data        = ALLOC_N(char, size);
+  row->layout      = layout;
+  row->connection  = connection;
+  row->transaction = transaction;
+  row->intern      = intern;
+  row->trim        = trim;
+  row->decimal     = decimal;
+  row->inlining    = inlining;
+  for(index = 0, entry = output->sqlvar; index < output->sqld;
+      index++, entry++) {
+    if(row->offsets[index] != ROW_DECODED) {
+      long length = entry->sqllen;
+
+      if((entry->sqltype & ~1) == SQL_VARYING) {
+        short actual;
+
+        memcpy(&actual, entry->sqldata, 2);
+        length = actual + 2;
+      }
+      memcpy(&row->data[row->offsets[index]], entry->sqldata, length);
+    }
+  }
+
+  return(self);
+}
+
+
+/**
+ * This function creates the layout shared by the lazy rows of a statement,
+ * holding a copy of the output column descriptions needed to decode them.
+ *
+ * @param  output     A pointer to the statement output area.
+ * @param  encodings  A pointer to the Ruby encoding indexes of the statement
+ *                    columns.
+ *
+ * @return  A reference to the newly created layout object.
+ *
+ */
+VALUE rb_row_layout_new(XSQLDA *output, int *encodings) {
+  RowLayout *layout = ALLOC(RowLayout);
+
+  layout->count     = output->sqld;
+  layout->columns   = ALLOC_N(XSQLVAR, output->sqld);
+  layout->encodings = ALLOC_N(int, output->sqld);
+  memcpy(layout->columns, output->sqlvar, sizeof(XSQLVAR) * output->sqld);
+  memcpy(layout->encodings, encodings, sizeof(int) * output->sqld);
+
+  return(Data_Wrap_Struct(cRowLayout, NULL, rowLayoutFree, layout));
+}
+
+
+/**
+ * This function sets the number of a row within its result set.
+ *
+ * @param  self    A reference to the Row object.
+ * @param  number  The number of the row.
+ *
+ */
+void setRowNumber(VALUE self, long number) {
+  RowHandle *row = NULL;
+
+  Data_Get_Struct(self, RowHandle, row);
+  row->number = number;
+}
+
+
+/**
+ * This function integrates with the Ruby garbage collector to mark the
+ * objects referenced by a Row object.
+ *
+ * @param  handle  A pointer to the RowHandle structure for the Row object.
+ *
+ */
+static void rowMark(void *handle) {
+  RowHandle *row = (RowHandle *)handle;
+
+  rb_gc_mark(row->metadata);
+  rb_gc_mark(row->columns);
+  rb_gc_mark(row->values);
+  rb_gc_mark(row->layout);
+  rb_gc_mark(row->connection);
+  rb_gc_mark(row->transaction);
+}
+
+
+/**
+ * This function integrates with the Ruby garbage collector to release the
+ * resources associated with a Row object that is being collected.
+ *
+ * @param  handle  A pointer to the RowHandle structure for the Row object.
+ *
+ */
+static void rowFree(void *handle) {
+  if(handle != NULL) {
+    RowHandle *row = (RowHandle *)handle;
+
+    if(row->data != NULL) {
+      free(row->data);
+    }
+    if(row->offsets != NULL) {
+      free(row->offsets);
+    }
+    free(handle);
+  }
+}
+
+
+/**
+ * This function integrates with the Ruby garbage collector to release the
+ * resources associated with a row layout that is being collected.
+ *
+ * @param  handle  A pointer to the RowLayout structure for the layout.
+ *
+ */
+static void rowLayoutFree(void *handle) {
+  if(handle != NULL) {
+    RowLayout *layout = (RowLayout *)handle;
+
+    free(layout->columns);
+    free(layout->encodings);
+    free(handle);
+  }
+}
+
+
+/**
+ * This function initializes the Row class within the Ruby environment.
+ *
+ * @param  module  A reference to the module to create the class within.
+ *
+ */
+void Init_Row(VALUE module) {
+  RB_INTERN_AT_NAME = rb_intern("@name");
+  RB_INTERN_AT_ALIAS = rb_intern("@alias");
+  RB_INTERN_AT_KEY = rb_intern("@key");
+  RB_INTERN_AT_TYPE = rb_intern("@type");
+  RB_INTERN_AT_SCALE = rb_intern("@scale");
+
+  cRow = rb_define_class_under(module, "Row", rb_cObject);
+  cRowLayout = rb_class_new(rb_cObject);
+  rb_undef_alloc_func(cRowLayout);
+  rb_global_variable(&cRowLayout);
+  rb_include_module(cRow, rb_mEnumerable);
+  rb_define_alloc_func(cRow, allocateRow);
+  rb_define_method(cRow, "initialize", initializeRow, 3);
+  rb_define_method(cRow, "initialize_copy", copyRow, 1);
+  rb_define_method(cRow, "number", getRowNumber, 0);
+  rb_define_method(cRow, "column_count", getRowColumnCount, 0);
+  rb_define_method(cRow, "column_name", getRowColumnName, 1);
+  rb_define_method(cRow, "column_alias", getRowColumnAlias, 1);
+  rb_define_method(cRow, "column_scale", getRowColumnScale, 1);
+  rb_define_method(cRow, "get_base_type", getRowColumnBaseType, 1);
+  rb_define_method(cRow, "each", eachRowValue, 0);
+  rb_define_method(cRow, "each_key", eachRowKey, 0);
+  rb_define_method(cRow, "each_value", eachRowValueOnly, 0);
+  rb_define_method(cRow, "[]", getRowValue, 1);
+  rb_define_method(cRow, "fetch", fetchRowValue, -1);
+  rb_define_method(cRow, "has_key?", rowHasKey, 1);
+  rb_define_method(cRow, "has_column?", rowHasColumn, 1);
+  rb_define_method(cRow, "has_alias?", rowHasAlias, 1);
+  rb_define_method(cRow, "has_value?", rowHasValue, 1);
+  rb_define_method(cRow, "keys", getRowKeys, 0);
+  rb_define_method(cRow, "names", getRowNames, 0);
+  rb_define_method(cRow, "aliases", getRowAliases, 0);
+  rb_define_method(cRow, "values", getRowValues, 0);
+  rb_define_method(cRow, "select", selectRowEntries, 0);
+  rb_define_method(cRow, "to_a", rowToArray, 0);
+  rb_define_method(cRow, "to_hash", rowToHash, 0);
+  rb_define_method(cRow, "values_at", rowValuesAt, -1);
+  rb_define_alias(cRow, "each_pair", "each");
+  rb_define_alias(cRow, "include?", "has_key?");
+  rb_define_alias(cRow, "key?", "has_key?");
+  rb_define_alias(cRow, "member?", "has_key?");
+  rb_define_alias(cRow, "value?", "has_value?");
+  rb_define_alias(cRow, "length", "column_count");
+  rb_define_alias(cRow, "size", "column_count");
+}
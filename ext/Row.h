@@ -0,0 +1,54 @@
+/*------------------------------------------------------------------------------
+ * Row.h
+ *----------------------------------------------------------------------------*/
+#ifndef FIRERUBY_ROW_H
+#define FIRERUBY_ROW_H
+
+/* Includes. */
+   #ifndef IBASE_H_INCLUDED
+      #include "ibase.h"
+      #define IBASE_H_INCLUDED
+   #endif
+
+   #ifndef RUBY_H_INCLUDED
+      #include "ruby.h"
+      #define RUBY_H_INCLUDED
+   #endif
+
+/* Type definitions. */
+typedef struct {
+  VALUE metadata,
+        columns,
+        values,
+        layout,
+        connection,
+        transaction;
+  long  number,
+        *offsets,
+        remaining,
+        inlining;
+  char  *data;
+  short intern,
+        trim,
+        decimal;
+} RowHandle;
+
+typedef struct {
+  XSQLVAR *columns;
+  int     *encodings,
+          count;
+} RowLayout;
+
+/* Data elements. */
+extern VALUE cRow;
+
+/* Function prototypes. */
+VALUE rb_row_new(VALUE, VALUE, VALUE, long);
+VALUE rb_lazy_row_new(VALUE, VALUE, VALUE, XSQLDA *, VALUE, VALUE, short,
+                      short, short, long);
+VALUE rb_row_layout_new(XSQLDA *, int *);
+void setRowNumber(VALUE, long);
+VALUE createColumnIndex(VALUE);
+void Init_Row(VALUE);
+
+#endif /* FIRERUBY_ROW_H */
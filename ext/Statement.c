@@ -30,6 +30,21 @@
 #include "Transaction.h"
 #include "DataArea.h"
 #include "TypeMap.h"
+#include "ResultSet.h"
+#include "Row.h"
+#include "rfbgvl.h"
+
+/* Type definitions. */
+typedef struct {
+  VALUE self,
+        transaction,
+        parameters;
+  StatementHandle   *statement;
+  TransactionHandle *hTransaction;
+  ConnectionHandle  *hConnection;
+  short affected;
+  long count;
+} BatchState;
 
 /* Function prototypes. */
 static VALUE allocateStatement(VALUE);
@@ -53,18 +68,42 @@ static VALUE execStatementFromArray(VALUE);
 static VALUE rescueStatement(VALUE, VALUE);
 static VALUE execInTransactionFromArray(VALUE);
 static VALUE execInTransaction(VALUE, VALUE, VALUE);
+static XSQLDA *bindStatement(VALUE, StatementHandle *, VALUE, VALUE);
+static VALUE execBatchRow(VALUE);
+static VALUE execBatchInTransaction(VALUE, VALUE, VALUE, VALUE);
+static VALUE execBatchFromArray(VALUE);
+static VALUE execBatch(int, VALUE *, VALUE);
+static VALUE getStatementInputLength(VALUE);
 static void prepareInTransaction(VALUE, VALUE);
 static VALUE prepareFromArray(VALUE);
+static void statementMark(void *);
 static void statementFree(void *);
 static StatementHandle* getPreparedHandle(VALUE self);
+static VALUE fetchColumns(int, VALUE *, VALUE);
+static VALUE getStatementInternStrings(VALUE);
+static VALUE setStatementInternStrings(VALUE, VALUE);
+static VALUE getStatementTrimChar(VALUE);
+static VALUE setStatementTrimChar(VALUE, VALUE);
+static VALUE getStatementLazyRows(VALUE);
+static VALUE setStatementLazyRows(VALUE, VALUE);
+static VALUE getStatementInlineBlobs(VALUE);
+static VALUE setStatementInlineBlobs(VALUE, VALUE);
+static VALUE getCachedMetadata(VALUE, XSQLDA *, VALUE);
+static VALUE getStatementDatabaseKey(VALUE);
+static void clearCachedMetadata(VALUE);
+static XSQLDA *describeArea(isc_stmt_handle *, short, int, short);
+static int *getColumnEncodings(XSQLDA *, VALUE);
 
 /* Globals. */
-static VALUE cStatement;
+static VALUE cStatement,
+             metadataCache;
+
+/* The maximum number of SQL texts cached per database before the metadata
+   cache for the database is cleared. */
+#define METADATA_CACHE_LIMIT 1024
 
 static ID
   RB_INTERN_CREATE_COLUMN_METADATA,
-  RB_INTERN_CREATE_RESULT_SET,
-  RB_INTERN_IS_ACTIVE_RESULT_SET,
   RB_INTERN_AT_NAME,
   RB_INTERN_AT_ALIAS,
   RB_INTERN_AT_KEY,
@@ -72,8 +111,7 @@ static ID
   RB_INTERN_AT_SCALE,
   RB_INTERN_AT_RELATION,
   RB_INTERN_AT_METADATA,
-  RB_INTERN_AT_MANAGE_STATEMENT,
-  RB_INTERN_AT_MANAGE_TRANSACTION,
+  RB_INTERN_AT_COLUMN_INDEX,
   RB_INTERN_ACTIVE,
   RB_INTERN_EACH,
   RB_INTERN_COMMIT,
@@ -89,6 +127,32 @@ static const ISC_STATUS FETCH_MORE = 0;
 static const ISC_STATUS FETCH_COMPLETED = 100;
 static const ISC_STATUS FETCH_ONE = 101;
 
+/* The statement details requested when a statement is prepared. */
+static char PREPARE_INFO_ITEMS[] = {isc_info_sql_stmt_type,
+                                    isc_info_sql_bind,
+                                    isc_info_sql_describe_vars,
+                                    isc_info_sql_sqlda_seq,
+                                    isc_info_sql_type,
+                                    isc_info_sql_sub_type,
+                                    isc_info_sql_scale,
+                                    isc_info_sql_length,
+                                    isc_info_sql_describe_end,
+                                    isc_info_sql_select,
+                                    isc_info_sql_describe_vars,
+                                    isc_info_sql_sqlda_seq,
+                                    isc_info_sql_type,
+                                    isc_info_sql_sub_type,
+                                    isc_info_sql_scale,
+                                    isc_info_sql_length,
+                                    isc_info_sql_field,
+                                    isc_info_sql_relation,
+                                    isc_info_sql_owner,
+                                    isc_info_sql_alias,
+                                    isc_info_sql_describe_end};
+
+/* The size of the buffer receiving the statement details. */
+#define PREPARE_INFO_LENGTH 16384
+
 /**
  * This function prepares a Firebird SQL statement for execution.
  *
@@ -106,50 +170,124 @@ static const ISC_STATUS FETCH_ONE = 101;
  *                      the parameters for the SQL statement.
  * @param  outputs      A pointer to an integer that will be assigned a count of
  *                      the output columns for the SQL statement.
+ * @param  input        A pointer that will be assigned the described input
+ *                      XSQLDA, or NULL if the statement has no parameters.
+ * @param  output       A pointer that will be assigned the described output
+ *                      XSQLDA, or NULL if the statement has no output columns.
  *
  */
 void fb_prepare(isc_db_handle *connection, isc_tr_handle *transaction,
              char *sql, isc_stmt_handle *statement, short dialect,
-             int *type, int *inputs, int *outputs) {
+             int *type, int *inputs, int *outputs, XSQLDA **input,
+             XSQLDA **output) {
   ISC_STATUS status[ISC_STATUS_LENGTH];
-  XSQLDA     *da    = NULL;
-  char list[] = {isc_info_sql_stmt_type},
-       info[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  int        bound     = -1,
+             selected  = -1;
+  char       *position = NULL,
+             *end      = NULL,
+             info[PREPARE_INFO_LENGTH];
+
+  *type    = 0;
+  *inputs  = 0;
+  *outputs = 0;
+  *input   = NULL;
+  *output  = NULL;
 
   /* Prepare the statement. */
   if(isc_dsql_allocate_statement(status, connection, statement)) {
     rb_fireruby_raise(status, "Error allocating a SQL statement.");
   }
 
-  da = (XSQLDA *)ALLOC_N(char, XSQLDA_LENGTH(1));
-  if(da == NULL) {
-    rb_raise(rb_eNoMemError,
-             "Memory allocation failure preparing a statement.");
-  }
-  da->version = SQLDA_VERSION1;
-  da->sqln    = 1;
-  if(isc_dsql_prepare(status, transaction, statement, 0, sql, dialect,
-                      da)) {
-    free(da);
+  if(rfb_dsql_prepare(status, transaction, statement, sql, dialect, NULL,
+                      connection)) {
     rb_fireruby_raise(status, "Error preparing a SQL statement.");
   }
-  *outputs = da->sqld;
 
-  /* Get the parameter count. */
-  if(isc_dsql_describe_bind(status, statement, dialect, da)) {
-    free(da);
-    rb_fireruby_raise(status, "Error determining statement parameters.");
+  /* Fetch the statement type and both descriptions in one request. */
+  if(isc_dsql_sql_info(status, statement, sizeof(PREPARE_INFO_ITEMS),
+                       PREPARE_INFO_ITEMS, sizeof(info), info)) {
+    rb_fireruby_raise(status, "Error determining SQL statement details.");
+  }
+
+  position = info;
+  end      = info + sizeof(info);
+  while(position != NULL && position < end && *position != isc_info_end) {
+    char item = *position++;
+
+    switch(item) {
+    case isc_info_sql_stmt_type:
+      if(end - position < 2) {
+        position = NULL;
+      } else {
+        short length = (short)isc_vax_integer(position, 2);
+
+        *type     = isc_vax_integer(position + 2, length);
+        position += 2 + length;
+      }
+      break;
+
+    case isc_info_sql_bind:
+      position = parseXSQLDAInfo(position, end, &bound, input);
+      break;
+
+    case isc_info_sql_select:
+      position = parseXSQLDAInfo(position, end, &selected, output);
+      break;
+
+    default:
+      /* The details were truncated, describe whatever is left over. */
+      position = NULL;
+    }
   }
-  *inputs = da->sqld;
-  free(da);
 
-  /* Get the statement type details. */
-  if(isc_dsql_sql_info(status, statement, 1, list, 20, info) ||
-     info[0] != isc_info_sql_stmt_type) {
-    rb_fireruby_raise(status, "Error determining SQL statement type.");
+  if(*type == 0) {
+    rb_fireruby_raise(NULL, "Error determining SQL statement type.");
   }
-  *type = isc_vax_integer(&info[3], isc_vax_integer(&info[1], 2));
+  if(*input == NULL && bound != 0) {
+    *input = describeArea(statement, dialect, bound, 0);
+  }
+  if(*output == NULL && selected != 0) {
+    *output = describeArea(statement, dialect, selected, 1);
+  }
+  *inputs  = (*input != NULL ? (*input)->sqld : 0);
+  *outputs = (*output != NULL ? (*output)->sqld : 0);
+}
+
+/**
+ * This function describes the input or output of a prepared statement with a
+ * separate call to the server. It is used when the details for a statement
+ * did not fit in the information requested when it was prepared.
+ *
+ * @param  statement  A pointer to the prepared statement handle.
+ * @param  dialect    The SQL dialect to be used in describing the statement.
+ * @param  count      The number of variables to be described, or -1 if this
+ *                    is not yet known.
+ * @param  output     1 to describe the output columns, 0 for the parameters.
+ *
+ * @return  A pointer to the described XSQLDA, or NULL if there are no
+ *          variables to describe.
+ *
+ */
+static XSQLDA *describeArea(isc_stmt_handle *statement, short dialect,
+                            int count, short output) {
+  XSQLDA *area = NULL;
+
+  if(count < 0) {
+    area  = (output ? allocateOutXSQLDA(1, statement, dialect) :
+             allocateInXSQLDA(1, statement, dialect));
+    count = area->sqld;
+    if(count <= 1) {
+      if(count == 0) {
+        free(area);
+        area = NULL;
+      }
+      return(area);
+    }
+    free(area);
+  }
+
+  return(output ? allocateOutXSQLDA(count, statement, dialect) :
+         allocateInXSQLDA(count, statement, dialect));
 }
 
 /**
@@ -207,6 +345,19 @@ VALUE getStatementMetadata(VALUE self) {
   return rb_ivar_get(self, RB_INTERN_AT_METADATA);
 }
 
+/**
+ * This function fetches the Hash of column keys to column offsets built for a
+ * statement when it was prepared.
+ *
+ * @param  self  A reference to the Statement object.
+ *
+ * @return  A reference to a frozen Hash.
+ *
+ */
+VALUE getStatementColumnIndex(VALUE self) {
+  return rb_ivar_get(self, RB_INTERN_AT_COLUMN_INDEX);
+}
+
 /**
  * Prepare statement parsing arguments array
  *
@@ -244,42 +395,214 @@ void prepareInTransaction(VALUE self, VALUE transaction) {
     fb_prepare(&hConnection->handle, &hTransaction->handle,
             StringValuePtr(sql), &hStatement->handle,
             hStatement->dialect, &hStatement->type, &hStatement->inputs,
-            &hStatement->outputs);
+            &hStatement->outputs, &hStatement->input, &hStatement->output);
 
-    metadata = rb_ary_new2(hStatement->outputs);
-    rb_ivar_set(self, RB_INTERN_AT_METADATA, metadata);
+    if(hStatement->inputs > 0) {
+      /* Set up the XSQLDA used to bind parameters on every execution. */
+      prepareDataArea(hStatement->input);
+      hStatement->parameters = describeParameters(hStatement->input);
+    }
 
     if(hStatement->outputs > 0) {
-      int index;
-      XSQLVAR *var;
-      VALUE column, name, alias, key_flag = getFireRubySetting("ALIAS_KEYS");
-
-      /* Allocate the XSQLDA */
-      hStatement->output = allocateOutXSQLDA(hStatement->outputs,
-                                               &hStatement->handle,
-                                               hStatement->dialect);
+      VALUE entry;
+
       prepareDataArea(hStatement->output);
+      hStatement->encodings = getColumnEncodings(hStatement->output,
+                                                 getStatementConnection(self));
 
-      var = hStatement->output->sqlvar;
-      for(index = 0; index < hStatement->output->sqld; index++, var++) {
-        column = rb_funcall(self, RB_INTERN_CREATE_COLUMN_METADATA, 0);
-        rb_ary_store(metadata, index, column);
-        name = rb_str_new(var->sqlname, var->sqlname_length);
-        alias = rb_str_new(var->aliasname, var->aliasname_length);
-        rb_ivar_set(column, RB_INTERN_AT_NAME, name);
-        rb_ivar_set(column, RB_INTERN_AT_ALIAS, alias);
-        if(key_flag == Qtrue) {
-          rb_ivar_set(column, RB_INTERN_AT_KEY, alias);
-        } else {
-          rb_ivar_set(column, RB_INTERN_AT_KEY, name);
-        }
-        rb_ivar_set(column, RB_INTERN_AT_TYPE, getColumnType(var));
-        rb_ivar_set(column, RB_INTERN_AT_SCALE, INT2FIX(var->sqlscale));
-        rb_ivar_set(column, RB_INTERN_AT_RELATION, rb_str_new(var->relname, var->relname_length));
-      }
-      rb_obj_freeze(metadata);
+      entry = getCachedMetadata(self, hStatement->output, sql);
+      rb_ivar_set(self, RB_INTERN_AT_METADATA, rb_ary_entry(entry, 0));
+      rb_ivar_set(self, RB_INTERN_AT_COLUMN_INDEX, rb_ary_entry(entry, 1));
+    } else {
+      metadata = rb_ary_new2(0);
+      rb_ivar_set(self, RB_INTERN_AT_METADATA, metadata);
+      rb_ivar_set(self, RB_INTERN_AT_COLUMN_INDEX, createColumnIndex(metadata));
+    }
+  }
+}
+
+/**
+ * This function resolves the Ruby encoding for each of the output columns of
+ * a prepared statement, so that column values can be converted to Strings
+ * without looking the encoding up again for every value.
+ *
+ * @param  output      A pointer to the described output XSQLDA.
+ * @param  connection  A reference to the Connection object for the statement.
+ *
+ * @return  A pointer to an array of encoding indices, one for each output
+ *          column. The caller is responsible for releasing the array.
+ *
+ */
+static int *getColumnEncodings(XSQLDA *output, VALUE connection) {
+  int     *encodings = ALLOC_N(int, output->sqld),
+          index;
+  XSQLVAR *var       = output->sqlvar;
+
+  for(index = 0; index < output->sqld; index++, var++) {
+    switch(var->sqltype & ~1) {
+    case SQL_TEXT:
+    case SQL_VARYING:
+      encodings[index] = getConnectionEncoding(connection, var->sqlsubtype);
+      break;
+
+    case SQL_BLOB:
+      encodings[index] = getConnectionEncoding(connection, var->sqlscale);
+      break;
+
+    default:
+      encodings[index] = 0;
     }
   }
+
+  return(encodings);
+}
+
+/**
+ * This function creates the column metadata for the output of a prepared
+ * statement. The metadata, the column objects and their strings are frozen
+ * so that they can be shared between statements.
+ *
+ * @param  self      A reference to the Statement object.
+ * @param  output    A pointer to the described output XSQLDA.
+ * @param  key_flag  The ALIAS_KEYS setting, true if column aliases rather
+ *                   than column names are to be used as column keys.
+ *
+ * @return  A reference to a frozen Array of column metadata objects.
+ *
+ */
+static VALUE createMetadata(VALUE self, XSQLDA *output, VALUE key_flag) {
+  VALUE   metadata = rb_ary_new2(output->sqld),
+          column, name, alias;
+  XSQLVAR *var     = output->sqlvar;
+  int     index;
+
+  for(index = 0; index < output->sqld; index++, var++) {
+    column = rb_funcall(self, RB_INTERN_CREATE_COLUMN_METADATA, 0);
+    rb_ary_store(metadata, index, column);
+    name = rb_obj_freeze(rb_str_new(var->sqlname, var->sqlname_length));
+    alias = rb_obj_freeze(rb_str_new(var->aliasname, var->aliasname_length));
+    rb_ivar_set(column, RB_INTERN_AT_NAME, name);
+    rb_ivar_set(column, RB_INTERN_AT_ALIAS, alias);
+    if(key_flag == Qtrue) {
+      rb_ivar_set(column, RB_INTERN_AT_KEY, alias);
+    } else {
+      rb_ivar_set(column, RB_INTERN_AT_KEY, name);
+    }
+    rb_ivar_set(column, RB_INTERN_AT_TYPE, getColumnType(var));
+    rb_ivar_set(column, RB_INTERN_AT_SCALE, INT2FIX(var->sqlscale));
+    rb_ivar_set(column, RB_INTERN_AT_RELATION,
+                rb_obj_freeze(rb_str_new(var->relname, var->relname_length)));
+    rb_obj_freeze(column);
+  }
+
+  return(rb_obj_freeze(metadata));
+}
+
+/**
+ * This function checks that cached column metadata still describes the
+ * output of a prepared statement.
+ *
+ * @param  metadata  A reference to the cached column metadata.
+ * @param  output    A pointer to the described output XSQLDA.
+ *
+ * @return  1 if the metadata matches the output columns, 0 otherwise.
+ *
+ */
+static short metadataMatches(VALUE metadata, XSQLDA *output) {
+  XSQLVAR *var = output->sqlvar;
+  int     index;
+
+  if(RARRAY_LEN(metadata) != output->sqld) {
+    return(0);
+  }
+  for(index = 0; index < output->sqld; index++, var++) {
+    VALUE column   = rb_ary_entry(metadata, index),
+          name     = rb_ivar_get(column, RB_INTERN_AT_NAME),
+          alias    = rb_ivar_get(column, RB_INTERN_AT_ALIAS),
+          relation = rb_ivar_get(column, RB_INTERN_AT_RELATION);
+
+    if(RSTRING_LEN(name) != var->sqlname_length ||
+       memcmp(RSTRING_PTR(name), var->sqlname, var->sqlname_length) != 0 ||
+       RSTRING_LEN(alias) != var->aliasname_length ||
+       memcmp(RSTRING_PTR(alias), var->aliasname, var->aliasname_length) != 0 ||
+       RSTRING_LEN(relation) != var->relname_length ||
+       memcmp(RSTRING_PTR(relation), var->relname, var->relname_length) != 0 ||
+       rb_ivar_get(column, RB_INTERN_AT_SCALE) != INT2FIX(var->sqlscale) ||
+       rb_ivar_get(column, RB_INTERN_AT_TYPE) != getColumnType(var)) {
+      return(0);
+    }
+  }
+
+  return(1);
+}
+
+/**
+ * This function fetches the column metadata for a prepared statement from the
+ * process wide metadata cache, creating and caching it if needed. Entries are
+ * kept per database and SQL text, so statements with identical SQL share one
+ * frozen metadata Array and column index.
+ *
+ * @param  self    A reference to the Statement object.
+ * @param  output  A pointer to the described output XSQLDA.
+ * @param  sql     A reference to the SQL text of the statement.
+ *
+ * @return  A reference to a frozen Array holding the metadata, the column
+ *          index and the ALIAS_KEYS setting the metadata was created with.
+ *
+ */
+static VALUE getCachedMetadata(VALUE self, XSQLDA *output, VALUE sql) {
+  VALUE key_flag = getFireRubySetting("ALIAS_KEYS"),
+        database = getStatementDatabaseKey(self),
+        entries  = rb_hash_lookup(metadataCache, database),
+        entry    = Qnil,
+        metadata;
+
+  if(entries == Qnil) {
+    entries = rb_hash_new();
+    rb_hash_aset(metadataCache, database, entries);
+  }
+
+  entry = rb_hash_lookup(entries, sql);
+  if(entry != Qnil && rb_ary_entry(entry, 2) == key_flag &&
+     metadataMatches(rb_ary_entry(entry, 0), output)) {
+    return(entry);
+  }
+
+  if(RHASH_SIZE(entries) >= METADATA_CACHE_LIMIT) {
+    rb_hash_clear(entries);
+  }
+  metadata = createMetadata(self, output, key_flag);
+  entry    = rb_ary_new3(3, metadata, createColumnIndex(metadata), key_flag);
+  rb_hash_aset(entries, sql, rb_obj_freeze(entry));
+
+  return(entry);
+}
+
+/**
+ * This function fetches the key used for the database of a statement in the
+ * metadata cache, which is the file specification of the database.
+ *
+ * @param  self  A reference to the Statement object.
+ *
+ * @return  A reference to a String identifying the database.
+ *
+ */
+static VALUE getStatementDatabaseKey(VALUE self) {
+  VALUE database = rb_iv_get(getStatementConnection(self), "@database");
+
+  return(rb_iv_get(database, "@file"));
+}
+
+/**
+ * This function drops the cached column metadata for the database of a
+ * statement. It is called after DDL, which may change the output of any
+ * statement against the database.
+ *
+ * @param  self  A reference to the Statement object.
+ *
+ */
+static void clearCachedMetadata(VALUE self) {
+  rb_hash_delete(metadataCache, getStatementDatabaseKey(self));
 }
 
 /**
@@ -304,9 +627,20 @@ VALUE allocateStatement(VALUE klass) {
   statement->inputs     = 0;
   statement->outputs    = 0;
   statement->dialect    = 0;
+  statement->cacheable  = 0;
+  statement->intern     = 0;
+  statement->trim       = 0;
+  statement->lazy       = 0;
+  statement->decimal    = 0;
+  statement->inlining   = 0;
+  statement->generation = 0;
+  statement->layout     = Qnil;
   statement->output     = NULL;
+  statement->input      = NULL;
+  statement->parameters = NULL;
+  statement->encodings  = NULL;
 
-  return(Data_Wrap_Struct(klass, NULL, statementFree, statement));
+  return(Data_Wrap_Struct(klass, statementMark, statementFree, statement));
 }
 
 
@@ -340,8 +674,15 @@ VALUE initializeStatement(VALUE self, VALUE connection, VALUE sql) {
 
   Data_Get_Struct(self, StatementHandle, hStatement);
   rb_iv_set(self, "@connection", connection);
-  rb_iv_set(self, "@sql", sql);
+  /* The text is read without the GVL when preparing, so a frozen copy is
+     kept that other threads can not change. */
+  StringValue(sql);
+  rb_iv_set(self, "@sql", rb_str_new_frozen(sql));
   hStatement->dialect = 3; //FIXME - from connection
+  hStatement->intern  = RTEST(getFireRubySetting("INTERN_STRINGS"));
+  hStatement->trim    = RTEST(getFireRubySetting("TRIM_CHAR"));
+  hStatement->lazy    = RTEST(getFireRubySetting("LAZY_ROWS"));
+  setStatementInlineBlobs(self, getFireRubySetting("INLINE_BLOBS"));
 
   return(self);
 }
@@ -392,6 +733,141 @@ VALUE getStatementDialect(VALUE self) {
   return(INT2FIX(hStatement->dialect));
 }
 
+/**
+ * This function provides the intern_strings? method for the Statement class.
+ *
+ * @param  self  A reference to the Statement object to call the method on.
+ *
+ * @return  True if CHAR and VARCHAR values are returned as frozen, interned
+ *          Strings, false otherwise.
+ *
+ */
+static VALUE getStatementInternStrings(VALUE self) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  return(hStatement->intern ? Qtrue : Qfalse);
+}
+
+/**
+ * This function provides the intern_strings= method for the Statement class.
+ *
+ * @param  self     A reference to the Statement object to call the method on.
+ * @param  setting  True to return CHAR and VARCHAR values as frozen, interned
+ *                  Strings, false to return a new String for each value.
+ *
+ * @return  A reference to the setting.
+ *
+ */
+static VALUE setStatementInternStrings(VALUE self, VALUE setting) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  hStatement->intern = RTEST(setting);
+  return(setting);
+}
+
+/**
+ * This function provides the trim_char? method for the Statement class.
+ *
+ * @param  self  A reference to the Statement object to call the method on.
+ *
+ * @return  True if the blanks padding CHAR values are removed, false
+ *          otherwise.
+ *
+ */
+static VALUE getStatementTrimChar(VALUE self) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  return(hStatement->trim ? Qtrue : Qfalse);
+}
+
+/**
+ * This function provides the trim_char= method for the Statement class.
+ *
+ * @param  self     A reference to the Statement object to call the method on.
+ * @param  setting  True to remove the blanks padding CHAR values, false to
+ *                  return them at their declared width.
+ *
+ * @return  A reference to the setting.
+ *
+ */
+static VALUE setStatementTrimChar(VALUE self, VALUE setting) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  hStatement->trim = RTEST(setting);
+  return(setting);
+}
+
+/**
+ * This function provides the lazy_rows? method for the Statement class.
+ *
+ * @param  self  A reference to the Statement object to call the method on.
+ *
+ * @return  True if the rows of the statement result sets decode their
+ *          columns on first access, false otherwise.
+ *
+ */
+static VALUE getStatementLazyRows(VALUE self) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  return(hStatement->lazy ? Qtrue : Qfalse);
+}
+
+/**
+ * This function provides the lazy_rows= method for the Statement class.
+ *
+ * @param  self     A reference to the Statement object to call the method on.
+ * @param  setting  True to have result set rows decode their columns on first
+ *                  access, false to decode all columns as rows are fetched.
+ *
+ * @return  A reference to the setting.
+ *
+ */
+static VALUE setStatementLazyRows(VALUE self, VALUE setting) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  hStatement->lazy = RTEST(setting);
+  return(setting);
+}
+
+/**
+ * This function provides the inline_blobs method for the Statement class.
+ *
+ * @param  self  A reference to the Statement object to call the method on.
+ *
+ * @return  The size in bytes up to which fetched blobs are returned as
+ *          Strings, 0 if blobs are always returned as Blob objects.
+ *
+ */
+static VALUE getStatementInlineBlobs(VALUE self) {
+  StatementHandle *hStatement = NULL;
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  return(LONG2NUM(hStatement->inlining));
+}
+
+/**
+ * This function provides the inline_blobs= method for the Statement class.
+ *
+ * @param  self     A reference to the Statement object to call the method on.
+ * @param  setting  The size in bytes up to which fetched blobs are to be
+ *                  returned as Strings, nil or false to always return Blob
+ *                  objects.
+ *
+ * @return  A reference to the setting.
+ *
+ */
+static VALUE setStatementInlineBlobs(VALUE self, VALUE setting) {
+  StatementHandle *hStatement = NULL;
+  long            inlining    = RTEST(setting) ? NUM2LONG(setting) : 0;
+
+  if(inlining < 0) {
+    rb_raise(rb_eArgError, "Negative inline blob size (%ld) specified.",
+             inlining);
+  }
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  hStatement->inlining = inlining;
+  return(setting);
+}
+
 /**
  * This function provides the type attribute accessor method for the Statement
  * class.
@@ -420,6 +896,33 @@ VALUE getStatementParameterCount(VALUE self) {
   return(INT2NUM(statement->inputs));
 }
 
+/**
+ * This function provides the input_length method for the Statement class.
+ *
+ * @param  self  A reference to the Statement object to call the method on.
+ *
+ * @return  A reference to an integer containing an upper bound, in bytes, of
+ *          the size of the message that carries the statement parameters.
+ *
+ */
+static VALUE getStatementInputLength(VALUE self) {
+  StatementHandle *statement = getPreparedHandle(self);
+  long length = 0;
+  int index;
+
+  for(index = 0; index < statement->inputs; index++) {
+    XSQLVAR *var = &statement->input->sqlvar[index];
+    long size    = var->sqllen;
+
+    if((var->sqltype & ~1) == SQL_VARYING) {
+      size += 2;
+    }
+    /* Allow for alignment of the value and its null indicator. */
+    length += ((size + 7) & ~7) + 8;
+  }
+  return(LONG2NUM(length));
+}
+
 /**
  * Execute statement and take care of implicit transaction management
  *
@@ -446,8 +949,8 @@ VALUE execAndManageTransaction(VALUE self, VALUE parameters, VALUE transaction)
     rb_ary_push(args, parameters);
     
     result = rb_rescue(execInTransactionFromArray, args, rescueLocalTransaction, transaction);
-    if(Qtrue == rb_funcall(self, RB_INTERN_IS_ACTIVE_RESULT_SET, 1, result)) {
-      rb_ivar_set(result, RB_INTERN_AT_MANAGE_TRANSACTION, Qtrue);
+    if(isActiveResultSet(result)) {
+      manageResultSetTransaction(result);
     } else {
       rb_funcall(transaction, RB_INTERN_COMMIT, 0);
     }
@@ -479,10 +982,10 @@ VALUE execAndManageStatement(VALUE self, VALUE parameters, VALUE transaction) {
   rb_ary_push(args, parameters);
   rb_ary_push(args, transaction);
   result = rb_rescue(execStatementFromArray, args, rescueStatement, self);
-  if(Qtrue == rb_funcall(self, RB_INTERN_IS_ACTIVE_RESULT_SET, 1, result)) {
-    rb_ivar_set(result, RB_INTERN_AT_MANAGE_STATEMENT, Qtrue);
+  if(isActiveResultSet(result)) {
+    manageResultSetStatement(result);
   } else {
-    closeStatement(self);
+    releaseStatement(self);
   }
   return (result);
 }
@@ -556,6 +1059,47 @@ static VALUE resultSetEach(VALUE resultSet) {
   return rb_funcall(resultSet, RB_INTERN_EACH, 0);
 }
 
+/**
+ * Bind a set of parameters to a prepared statement
+ *
+ * @param  self         A reference to the statement object
+ *
+ * @param  hStatement   A pointer to the statement handle
+ *
+ * @param  parameters   A reference to the parameter bindings object, can be
+ *                      Qnil for statements without inputs
+ *
+ * @param  transaction  A reference to the transaction object
+ *
+ * @return  A pointer to the bound input XSQLDA, NULL if the statement has no
+ *          inputs.
+ */
+static XSQLDA *bindStatement(VALUE self, StatementHandle *hStatement,
+                             VALUE parameters, VALUE transaction) {
+  VALUE value = Qnil;
+  int size  = 0;
+
+  if(hStatement->inputs == 0) {
+    return(NULL);
+  }
+
+  if(parameters == Qnil) {
+    rb_fireruby_raise(NULL,
+                      "Empty parameter list specified for statement.");
+  }
+
+  value = rb_funcall(parameters, RB_INTERN_SIZE, 0);
+  size  = TYPE(value) == T_FIXNUM ? FIX2INT(value) : NUM2INT(value);
+  if(size < hStatement->inputs) {
+    rb_fireruby_raise(NULL,
+                      "Insufficient parameters specified for statement.");
+  }
+
+  setParameters(hStatement->input, hStatement->parameters, parameters,
+                transaction, getStatementConnection(self));
+  return(hStatement->input);
+}
+
 /**
  * Execute a statement within a transaction context
  *
@@ -573,50 +1117,35 @@ VALUE execInTransaction(VALUE self, VALUE transaction, VALUE parameters) {
   long affected     = 0;
   StatementHandle   *hStatement   = NULL;
   TransactionHandle *hTransaction = NULL;
+  ConnectionHandle  *hConnection  = NULL;
   XSQLDA            *bindings = NULL;
   ISC_STATUS status[ISC_STATUS_LENGTH];
   ISC_STATUS execute_result;
 
   prepareInTransaction(self, transaction);
   Data_Get_Struct(self, StatementHandle, hStatement);
-  if(hStatement->inputs > 0) {
-    VALUE value = Qnil;
-    int size  = 0;
-
-    if(parameters == Qnil) {
-      rb_fireruby_raise(NULL,
-                        "Empty parameter list specified for statement.");
-    }
-
-    value = rb_funcall(parameters, RB_INTERN_SIZE, 0);
-    size  = TYPE(value) == T_FIXNUM ? FIX2INT(value) : NUM2INT(value);
-    if(size < hStatement->inputs) {
-      rb_fireruby_raise(NULL,
-                        "Insufficient parameters specified for statement.");
-    }
-
-    /* Allocate the XSQLDA */
-    bindings = allocateInXSQLDA(hStatement->inputs, &hStatement->handle, hStatement->dialect);
-    prepareDataArea(bindings);
-    setParameters(bindings, parameters, transaction, getStatementConnection(self));
-  }
+  hStatement->decimal = getDecimalMode();
+  bindings = bindStatement(self, hStatement, parameters, transaction);
 
   /* Execute the statement. */
   Data_Get_Struct(transaction, TransactionHandle, hTransaction);
+  Data_Get_Struct(getStatementConnection(self), ConnectionHandle, hConnection);
 
   if (isCursorStatement(hStatement)) {
-    execute_result = isc_dsql_execute(status, &hTransaction->handle, &hStatement->handle, hStatement->dialect, bindings);
+    execute_result = rfb_dsql_execute2(status, &hTransaction->handle, &hStatement->handle, hStatement->dialect, bindings, NULL, &hConnection->handle);
   } else {
-    execute_result = isc_dsql_execute2(status, &hTransaction->handle, &hStatement->handle, hStatement->dialect, bindings, hStatement->output);
-  }
-  if(bindings) {
-    releaseDataArea(bindings);
+    execute_result = rfb_dsql_execute2(status, &hTransaction->handle, &hStatement->handle, hStatement->dialect, bindings, hStatement->output, &hConnection->handle);
   }
   if(execute_result) {
     rb_fireruby_raise(status, "Error executing SQL statement.");
   }
+  if(hStatement->type == isc_info_sql_stmt_ddl) {
+    /* Cached statements may refer to objects the DDL has changed. */
+    clearStatementCache(getStatementConnection(self));
+    clearCachedMetadata(self);
+  }
   if (hStatement->output) {
-    result = rb_funcall(self, RB_INTERN_CREATE_RESULT_SET, 1, transaction);
+    result = rb_result_set_new(self, transaction);
     if(rb_block_given_p()) {
       result = rb_iterate(resultSetEach, result, rb_yield, 0);
     }
@@ -667,6 +1196,158 @@ VALUE execAndCloseStatement(int argc, VALUE *argv, VALUE self) {
   return execAndManageStatement(self, parameters, transaction);
 }
 
+/**
+ * Execute a single parameter set of a batch. This function is called through
+ * rb_protect when the batch continues past errors.
+ *
+ * @param  data  A pointer to the BatchState of the batch, cast to a VALUE
+ *
+ * @return  Qnil
+ */
+static VALUE execBatchRow(VALUE data) {
+  BatchState *batch = (BatchState *)data;
+  XSQLDA     *bindings = NULL;
+  ISC_STATUS status[ISC_STATUS_LENGTH];
+
+  bindings = bindStatement(batch->self, batch->statement, batch->parameters,
+                           batch->transaction);
+  if(rfb_dsql_execute2(status, &batch->hTransaction->handle,
+                       &batch->statement->handle, batch->statement->dialect,
+                       bindings, batch->statement->output,
+                       &batch->hConnection->handle)) {
+    rb_fireruby_raise(status, "Error executing SQL statement.");
+  }
+  if(batch->affected) {
+    batch->count += fb_query_affected(batch->statement);
+  }
+  return(Qnil);
+}
+
+/**
+ * Execute a statement once for each of a list of parameter sets within a
+ * transaction context
+ *
+ * @param  self         A reference to the statement object
+ *
+ * @param  transaction  A reference to the transaction object
+ *
+ * @param  rows         A reference to an Array of parameter sets
+ *
+ * @param  options      A reference to a Hash of batch options, can be Qnil
+ *
+ * @return  A Hash containing the number of parameter sets executed, the
+ *          total number of rows affected and the errors raised.
+ */
+static VALUE execBatchInTransaction(VALUE self, VALUE transaction, VALUE rows,
+                                    VALUE options) {
+  VALUE result = rb_hash_new(),
+        errors = rb_ary_new();
+  BatchState batch;
+  short resume = 0;
+  long i,
+       executed = 0;
+
+  if(TYPE(rows) != T_ARRAY) {
+    rb_fireruby_raise(NULL, "Invalid parameter set list specified for batch.");
+  }
+
+  prepareInTransaction(self, transaction);
+  batch.self        = self;
+  batch.transaction = transaction;
+  batch.parameters  = Qnil;
+  batch.affected    = 1;
+  batch.count       = 0;
+  Data_Get_Struct(self, StatementHandle, batch.statement);
+  Data_Get_Struct(transaction, TransactionHandle, batch.hTransaction);
+  Data_Get_Struct(getStatementConnection(self), ConnectionHandle,
+                  batch.hConnection);
+  if(isCursorStatement(batch.statement)) {
+    rb_fireruby_raise(NULL, "Queries cannot be executed as a batch.");
+  }
+  if(options != Qnil) {
+    batch.affected = rb_hash_aref(options, toSymbol("affected")) != Qfalse;
+    resume         = RTEST(rb_hash_aref(options, toSymbol("continue")));
+  }
+
+  for(i = 0; i < RARRAY_LEN(rows); i++) {
+    batch.parameters = rb_ary_entry(rows, i);
+    if(resume) {
+      int state = 0;
+
+      rb_protect(execBatchRow, (VALUE)&batch, &state);
+      if(state) {
+        VALUE error = rb_errinfo();
+
+        if(!rb_obj_is_kind_of(error, rb_eStandardError)) {
+          rb_jump_tag(state);
+        }
+        rb_set_errinfo(Qnil);
+        rb_ary_push(errors, rb_assoc_new(LONG2NUM(i), error));
+        continue;
+      }
+    } else {
+      execBatchRow((VALUE)&batch);
+    }
+    executed++;
+  }
+
+  rb_hash_aset(result, toSymbol("executed"), LONG2NUM(executed));
+  rb_hash_aset(result, toSymbol("affected"),
+               batch.affected ? LONG2NUM(batch.count) : Qnil);
+  rb_hash_aset(result, toSymbol("errors"), errors);
+  return(result);
+}
+
+/**
+ * Execute a batch within a transaction context parsing arguments array
+ *
+ * @param  args   Array containing statement, transaction, parameter sets and
+ *                options objects
+ *
+ * @return  A Hash of the batch results.
+ */
+static VALUE execBatchFromArray(VALUE args) {
+  return(execBatchInTransaction(rb_ary_entry(args, 0), rb_ary_entry(args, 1),
+                                rb_ary_entry(args, 2), rb_ary_entry(args, 3)));
+}
+
+/**
+ * This method provides the exec_batch method for the Statement class.
+ *
+ * @param  self       A reference to the Statement object to call the method on.
+ *
+ * @param  argc       Parameters count
+ *
+ * @param  argv       Parameters array
+ *
+ * @return  A Hash containing the number of parameter sets executed, the total
+ *          number of rows affected and the errors raised.
+ *
+ */
+static VALUE execBatch(int argc, VALUE *argv, VALUE self) {
+  VALUE rows, transaction, options = Qnil;
+
+  rb_scan_args(argc, argv, "12", &rows, &transaction, &options);
+  if(options != Qnil) {
+    Check_Type(options, T_HASH);
+  }
+  if(Qnil == transaction) {
+    VALUE args = rb_ary_new(),
+          result;
+
+    transaction = rb_transaction_new(getStatementConnection(self));
+    rb_ary_push(args, self);
+    rb_ary_push(args, transaction);
+    rb_ary_push(args, rows);
+    rb_ary_push(args, options);
+    result = rb_rescue(execBatchFromArray, args, rescueLocalTransaction,
+                       transaction);
+    rb_funcall(transaction, RB_INTERN_COMMIT, 0);
+    return(result);
+  }
+  return(execBatchInTransaction(self, transaction, rows, options));
+}
+
 /**
  * Clean up statement handle - release allocated resources
  *
@@ -686,7 +1367,18 @@ void cleanUpStatement(StatementHandle *statement, int raise_errors) {
     }
     if(statement->output != NULL) {
       releaseDataArea(statement->output);
-      statement->output = NULL;
+      free(statement->output);
+      free(statement->encodings);
+      statement->output    = NULL;
+      statement->encodings = NULL;
+      statement->layout    = Qnil;
+    }
+    if(statement->input != NULL) {
+      releaseDataArea(statement->input);
+      free(statement->input);
+      free(statement->parameters);
+      statement->input      = NULL;
+      statement->parameters = NULL;
     }
     statement->handle = 0;
   }
@@ -840,7 +1532,41 @@ VALUE execStatementFromArray(VALUE args) {
  *
  */
 VALUE rb_execute_sql(VALUE connection, VALUE sql, VALUE params, VALUE transaction) {
-  return execAndManageStatement(rb_statement_new(connection, sql), params, transaction);
+  StatementHandle *hStatement = NULL;
+  unsigned long   generation  = 0;
+  VALUE           statement   = checkoutStatement(connection, sql, &generation);
+
+  if(statement == Qnil) {
+    statement = rb_statement_new(connection, sql);
+    Data_Get_Struct(statement, StatementHandle, hStatement);
+    hStatement->cacheable = 1;
+  } else {
+    Data_Get_Struct(statement, StatementHandle, hStatement);
+  }
+  hStatement->generation = generation;
+
+  return execAndManageStatement(statement, params, transaction);
+}
+
+/**
+ * This function is called when a statement created by rb_execute_sql is no
+ * longer in use. The statement is returned to the statement cache of its
+ * connection where possible and closed otherwise.
+ *
+ * @param  self  A reference to the Statement object to be released.
+ *
+ */
+void releaseStatement(VALUE self) {
+  StatementHandle *hStatement = NULL;
+
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  if(hStatement->cacheable && hStatement->handle != 0 &&
+     hStatement->type != isc_info_sql_stmt_ddl &&
+     checkinStatement(getStatementConnection(self), getStatementSQL(self),
+                      self, hStatement->generation)) {
+    return;
+  }
+  cleanUpStatement(hStatement, 1);
 }
 
 /**
@@ -865,6 +1591,18 @@ StatementHandle* getPreparedHandle(VALUE self) {
   return (hStatement);
 }
 
+/**
+ * This function integrates with the Ruby garbage collector to mark the row
+ * layout held by a Statement object.
+ *
+ * @param  handle  A pointer to the StatementHandle structure for the Statement
+ *                 object.
+ *
+ */
+void statementMark(void *handle) {
+  rb_gc_mark(((StatementHandle *)handle)->layout);
+}
+
 /**
  * This function integrates with the Ruby garbage collector to release the
  * resources associated with a Statement object that is being collected.
@@ -882,6 +1620,7 @@ void statementFree(void *handle) {
 
 static VALUE fetch(VALUE self) {
   StatementHandle   *hStatement;
+  ConnectionHandle  *hConnection;
   ISC_STATUS        status[ISC_STATUS_LENGTH],
                     fetch_result;
 
@@ -891,8 +1630,9 @@ static VALUE fetch(VALUE self) {
   }
 
   if (isCursorStatement(hStatement)) {
-    fetch_result = isc_dsql_fetch(status, &hStatement->handle, hStatement->dialect,
-                           hStatement->output);
+    Data_Get_Struct(getStatementConnection(self), ConnectionHandle, hConnection);
+    fetch_result = rfb_dsql_fetch(status, &hStatement->handle, hStatement->dialect,
+                           hStatement->output, &hConnection->handle);
     if(fetch_result != FETCH_MORE && fetch_result != FETCH_COMPLETED) {
       rb_fireruby_raise(status, "Error fetching query row.");
     }
@@ -918,24 +1658,287 @@ static VALUE closeCursor(VALUE self) {
   return INT2FIX(close_result);
 }
 
-static VALUE currentRow(VALUE self, VALUE transaction) {
+/**
+ * This function converts the row currently held in the output area of a
+ * statement into an array of Ruby values.
+ *
+ * @param  hStatement   A pointer to the statement handle.
+ * @param  connection   A reference to the connection object for the statement.
+ * @param  transaction  A reference to the transaction the row was fetched in.
+ *
+ * @return  A reference to an Array containing the row values.
+ *
+ */
+static VALUE rowValues(StatementHandle *hStatement, VALUE connection,
+                       VALUE transaction) {
   int i;
-  XSQLVAR *entry;
+  XSQLVAR *entry = hStatement->output->sqlvar;
+  VALUE array    = rb_ary_new2(hStatement->output->sqln);
+
+  for(i = 0; i < hStatement->output->sqln; i++, entry++) {
+    rb_ary_store(array, i, toValue(entry, hStatement->encodings[i],
+                                   hStatement->intern, hStatement->trim,
+                                   hStatement->decimal, hStatement->inlining,
+                                   connection, transaction));
+  }
+  return(array);
+}
+
+/**
+ * This function creates a lazy Row object for the row currently held in the
+ * output area of a statement.
+ *
+ * @param  self         A reference to the Statement object.
+ * @param  hStatement   A pointer to the statement handle.
+ * @param  connection   A reference to the connection object for the statement.
+ * @param  transaction  A reference to the transaction the row was fetched in.
+ *
+ * @return  A reference to a Row object with a row number of zero.
+ *
+ */
+static VALUE lazyRow(VALUE self, StatementHandle *hStatement, VALUE connection,
+                     VALUE transaction) {
+  if(hStatement->layout == Qnil) {
+    hStatement->layout = rb_row_layout_new(hStatement->output,
+                                           hStatement->encodings);
+  }
+  return(rb_lazy_row_new(getStatementMetadata(self),
+                         getStatementColumnIndex(self), hStatement->layout,
+                         hStatement->output, connection, transaction,
+                         hStatement->intern, hStatement->trim,
+                         hStatement->decimal, hStatement->inlining));
+}
+
+static VALUE currentRow(VALUE self, VALUE transaction) {
   StatementHandle *hStatement;
-  VALUE array, connection;
 
   Data_Get_Struct(self, StatementHandle, hStatement);
   if (hStatement->outputs == 0) {
     rb_fireruby_raise(NULL, "Statement has no output.");
   }
 
-  connection  = getStatementConnection(self);
-  array       = rb_ary_new2(hStatement->output->sqln);
-  entry       = hStatement->output->sqlvar;
-  for(i = 0; i < hStatement->output->sqln; i++, entry++) {
-    rb_ary_store(array, i, toValue(entry, connection, transaction));
+  return(rowValues(hStatement, getStatementConnection(self), transaction));
+}
+
+/**
+ * This function fetches up to the requested number of rows from the statement
+ * cursor and converts them to Ruby values.
+ *
+ * @param  self         A reference to the Statement object to fetch from.
+ * @param  limit        The maximum number of rows to be fetched.
+ * @param  transaction  A reference to the transaction the rows are fetched in.
+ * @param  lazy         1 if lazy Row objects may be returned for a statement
+ *                      that has lazy rows enabled, 0 to always return row
+ *                      value Arrays.
+ *
+ * @return  A reference to an Array of row value Arrays, or of lazy Row
+ *          objects. Less than limit rows are returned only when the cursor
+ *          has been exhausted or when the statement is not a cursor
+ *          statement, in which case the single output row is returned.
+ *
+ */
+VALUE fetchStatementRows(VALUE self, long limit, VALUE transaction,
+                         short lazy) {
+  StatementHandle   *hStatement;
+  ConnectionHandle  *hConnection;
+  ISC_STATUS        status[ISC_STATUS_LENGTH],
+                    fetch_result;
+  long              index;
+  VALUE             rows, connection;
+
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  if (hStatement->outputs == 0) {
+    rb_fireruby_raise(NULL, "Statement has no output.");
   }
-  return(array);
+
+  connection = getStatementConnection(self);
+  rows       = rb_ary_new();
+  lazy       = lazy && hStatement->lazy;
+  if (!isCursorStatement(hStatement)) {
+    rb_ary_push(rows, lazy ? lazyRow(self, hStatement, connection, transaction) :
+                      rowValues(hStatement, connection, transaction));
+    return(rows);
+  }
+
+  Data_Get_Struct(connection, ConnectionHandle, hConnection);
+  for(index = 0; index < limit; index++) {
+    fetch_result = rfb_dsql_fetch(status, &hStatement->handle, hStatement->dialect,
+                                  hStatement->output, &hConnection->handle);
+    if(fetch_result == FETCH_COMPLETED) {
+      break;
+    }
+    if(fetch_result != FETCH_MORE) {
+      rb_fireruby_raise(status, "Error fetching query row.");
+    }
+    rb_ary_push(rows, lazy ? lazyRow(self, hStatement, connection, transaction) :
+                      rowValues(hStatement, connection, transaction));
+
+    /* Deliver any interrupt only once the fetched row has been converted. */
+    rb_thread_check_ints();
+  }
+
+  return(rows);
+}
+
+/**
+ * This function provides the fetch_batch method for the Statement class. Up
+ * to the requested number of rows are fetched from the statement cursor and
+ * converted to Ruby values within a single call.
+ *
+ * @param  self         A reference to the Statement object to call the method on.
+ * @param  count        The maximum number of rows to be fetched.
+ * @param  transaction  A reference to the transaction the rows are fetched in.
+ *
+ * @return  A reference to an Array of row value Arrays.
+ *
+ */
+static VALUE fetchBatch(VALUE self, VALUE count, VALUE transaction) {
+  long limit = NUM2LONG(count);
+
+  if (limit < 1) {
+    rb_raise(rb_eArgError, "Invalid row count (%ld) specified for fetch.", limit);
+  }
+
+  return(fetchStatementRows(self, limit, transaction, 0));
+}
+
+/**
+ * This function determines the width of the values of a column that can be
+ * returned as a packed binary String by the fetch_columns method.
+ *
+ * @param  var  A pointer to the XSQLVAR for the column.
+ *
+ * @return  The number of bytes in each value or 0 if the column values can't
+ *          be packed.
+ *
+ */
+static long getPackedWidth(XSQLVAR *var) {
+  switch(var->sqltype & ~1) {
+  case SQL_LONG:
+    return(sizeof(ISC_LONG));
+
+  case SQL_INT64:
+    return(sizeof(ISC_INT64));
+
+  case SQL_DOUBLE:
+    return(sizeof(double));
+
+  case SQL_TYPE_DATE:
+    return(sizeof(ISC_DATE));
+  }
+
+  return(0);
+}
+
+/**
+ * This function appends the value currently held in the output area for a
+ * column to the packed data and null bitmap for the column.
+ *
+ * @param  var     A pointer to the XSQLVAR for the column.
+ * @param  width   The number of bytes in each column value.
+ * @param  column  A reference to the Array holding the packed data String and
+ *                 the null bitmap String for the column.
+ * @param  row     The offset of the row within the fetched rows.
+ *
+ */
+static void packColumnValue(XSQLVAR *var, long width, VALUE column, long row) {
+  static const char ZERO[sizeof(double)] = {0};
+  VALUE data  = rb_ary_entry(column, 0),
+        nulls = rb_ary_entry(column, 1);
+
+  if(row % 8 == 0) {
+    rb_str_cat(nulls, ZERO, 1);
+  }
+  if((var->sqltype & 1) && *var->sqlind < 0) {
+    rb_str_cat(data, ZERO, width);
+    RSTRING_PTR(nulls)[row / 8] |= (char)(1 << (row % 8));
+  } else {
+    rb_str_cat(data, var->sqldata, width);
+  }
+}
+
+/**
+ * This function provides the fetch_columns method for the Statement class. Up
+ * to the requested number of rows are fetched from the statement cursor and
+ * returned column by column rather than row by row. With the packed option
+ * set, integer, double and date columns are returned as a binary String of
+ * native values with a null bitmap rather than as an Array of objects.
+ *
+ * @param  argc  A count of the arguments to the method.
+ * @param  argv  A pointer to the arguments to the method: the maximum number
+ *               of rows, the transaction and the optional packed flag.
+ * @param  self  A reference to the Statement object to call the method on.
+ *
+ * @return  A reference to an Array with an entry for each column.
+ *
+ */
+static VALUE fetchColumns(int argc, VALUE *argv, VALUE self) {
+  StatementHandle   *hStatement;
+  ConnectionHandle  *hConnection;
+  ISC_STATUS        status[ISC_STATUS_LENGTH],
+                    fetch_result;
+  XSQLVAR           *var;
+  long              limit, row, width;
+  int               index;
+  VALUE             count, transaction, packed, columns, connection;
+
+  rb_scan_args(argc, argv, "21", &count, &transaction, &packed);
+  limit = NUM2LONG(count);
+  if (limit < 1) {
+    rb_raise(rb_eArgError, "Invalid row count (%ld) specified for fetch.", limit);
+  }
+
+  Data_Get_Struct(self, StatementHandle, hStatement);
+  if (hStatement->outputs == 0) {
+    rb_fireruby_raise(NULL, "Statement has no output.");
+  }
+  if (!isCursorStatement(hStatement)) {
+    limit = 1;
+  }
+
+  columns = rb_ary_new2(hStatement->output->sqld);
+  var     = hStatement->output->sqlvar;
+  for(index = 0; index < hStatement->output->sqld; index++, var++) {
+    if(RTEST(packed) && getPackedWidth(var) > 0) {
+      rb_ary_push(columns, rb_ary_new3(2, rb_str_new(NULL, 0),
+                                          rb_str_new(NULL, 0)));
+    } else {
+      rb_ary_push(columns, rb_ary_new());
+    }
+  }
+
+  connection = getStatementConnection(self);
+  Data_Get_Struct(connection, ConnectionHandle, hConnection);
+  for(row = 0; row < limit; row++) {
+    if (isCursorStatement(hStatement)) {
+      fetch_result = rfb_dsql_fetch(status, &hStatement->handle,
+                                    hStatement->dialect, hStatement->output,
+                                    &hConnection->handle);
+      if(fetch_result == FETCH_COMPLETED) {
+        break;
+      }
+      if(fetch_result != FETCH_MORE) {
+        rb_fireruby_raise(status, "Error fetching query row.");
+      }
+    }
+
+    var = hStatement->output->sqlvar;
+    for(index = 0; index < hStatement->output->sqld; index++, var++) {
+      VALUE column = rb_ary_entry(columns, index);
+
+      if(RTEST(packed) && (width = getPackedWidth(var)) > 0) {
+        packColumnValue(var, width, column, row);
+      } else {
+        rb_ary_push(column, toValue(var, hStatement->encodings[index],
+                                    hStatement->intern, hStatement->trim,
+                                    hStatement->decimal, hStatement->inlining,
+                                    connection, transaction));
+      }
+    }
+    rb_thread_check_ints();
+  }
+
+  return(columns);
 }
 
 /**
@@ -947,8 +1950,6 @@ static VALUE currentRow(VALUE self, VALUE transaction) {
  */
 void Init_Statement(VALUE module) {
   RB_INTERN_CREATE_COLUMN_METADATA = rb_intern("create_column_metadata");
-  RB_INTERN_CREATE_RESULT_SET = rb_intern("create_result_set");
-  RB_INTERN_IS_ACTIVE_RESULT_SET = rb_intern("is_active_result_set");
   RB_INTERN_AT_NAME = rb_intern("@name");
   RB_INTERN_AT_ALIAS = rb_intern("@alias");
   RB_INTERN_AT_KEY = rb_intern("@key");
@@ -956,8 +1957,7 @@ void Init_Statement(VALUE module) {
   RB_INTERN_AT_SCALE = rb_intern("@scale");
   RB_INTERN_AT_RELATION = rb_intern("@relation");
   RB_INTERN_AT_METADATA = rb_intern("@metadata");
-  RB_INTERN_AT_MANAGE_STATEMENT = rb_intern("@manage_statement");
-  RB_INTERN_AT_MANAGE_TRANSACTION = rb_intern("@manage_transaction");
+  RB_INTERN_AT_COLUMN_INDEX = rb_intern("@column_index");
   RB_INTERN_ACTIVE = rb_intern("active?");
   RB_INTERN_EACH = rb_intern("each");
   RB_INTERN_COMMIT = rb_intern("commit");
@@ -969,6 +1969,9 @@ void Init_Statement(VALUE module) {
   RB_INTERN_OPEN = rb_intern("open?");
   RB_INTERN_STRIP = rb_intern("strip!");
 
+  metadataCache = rb_hash_new();
+  rb_global_variable(&metadataCache);
+
   cStatement = rb_define_class_under(module, "Statement", rb_cObject);
   rb_define_alloc_func(cStatement, allocateStatement);
   rb_define_method(cStatement, "initialize", initializeStatement, 2);
@@ -981,12 +1984,24 @@ void Init_Statement(VALUE module) {
   rb_define_method(cStatement, "exec_and_close", execAndCloseStatement, -1);
   rb_define_method(cStatement, "close", closeStatement, 0);
   rb_define_method(cStatement, "parameter_count", getStatementParameterCount, 0);
+  rb_define_method(cStatement, "input_length", getStatementInputLength, 0);
   rb_define_method(cStatement, "prepare", prepareStatement, -1);
   rb_define_method(cStatement, "prepared?", getStatementPrepared, 0);
   rb_define_method(cStatement, "plan", getStatementPlan, 0);
   rb_define_method(cStatement, "fetch", fetch, 0);
   rb_define_method(cStatement, "close_cursor", closeCursor, 0);
   rb_define_method(cStatement, "current_row", currentRow, 1);
+  rb_define_method(cStatement, "fetch_batch", fetchBatch, 2);
+  rb_define_method(cStatement, "fetch_columns", fetchColumns, -1);
+  rb_define_method(cStatement, "exec_batch", execBatch, -1);
+  rb_define_method(cStatement, "intern_strings?", getStatementInternStrings, 0);
+  rb_define_method(cStatement, "intern_strings=", setStatementInternStrings, 1);
+  rb_define_method(cStatement, "trim_char?", getStatementTrimChar, 0);
+  rb_define_method(cStatement, "trim_char=", setStatementTrimChar, 1);
+  rb_define_method(cStatement, "lazy_rows?", getStatementLazyRows, 0);
+  rb_define_method(cStatement, "lazy_rows=", setStatementLazyRows, 1);
+  rb_define_method(cStatement, "inline_blobs", getStatementInlineBlobs, 0);
+  rb_define_method(cStatement, "inline_blobs=", setStatementInlineBlobs, 1);
 
   rb_define_const(cStatement, "SELECT_STATEMENT",
                   INT2FIX(isc_info_sql_stmt_select));
@@ -36,14 +36,27 @@
       #define RUBY_H_INCLUDED
    #endif
 
+   #include "TypeMap.h"
+
 /* Type definitions. */
 typedef struct {
   isc_stmt_handle handle;
   int type,
       inputs,
       outputs;
-  short dialect;
-  XSQLDA          *output;
+  short dialect,
+        cacheable,
+        intern,
+        trim,
+        lazy,
+        decimal;
+  long            inlining;
+  unsigned long   generation;
+  VALUE           layout;
+  XSQLDA          *output,
+                  *input;
+  ParameterInfo   *parameters;
+  int             *encodings;
 } StatementHandle;
 
 /* Function prototypes. */
@@ -56,5 +69,8 @@ VALUE rb_execute_sql(VALUE, VALUE, VALUE, VALUE);
 void Init_Statement(VALUE);
 short isCursorStatement(StatementHandle*);
 VALUE getStatementMetadata(VALUE);
+VALUE getStatementColumnIndex(VALUE);
+VALUE fetchStatementRows(VALUE, long, VALUE, short);
+void releaseStatement(VALUE);
 
 #endif /* FIRERUBY_STATEMENT_H */
@@ -28,6 +28,7 @@
 #include "Common.h"
 #include "Connection.h"
 #include "Statement.h"
+#include "rfbgvl.h"
 
 /* Function prototypes. */
 static VALUE allocateTransaction(VALUE);
@@ -137,7 +138,7 @@ static VALUE commitTransaction(VALUE self) {
   if(transaction->handle != 0) {
     ISC_STATUS status[ISC_STATUS_LENGTH];
 
-    if(isc_commit_transaction(status, &transaction->handle) != 0) {
+    if(rfb_commit_transaction(status, &transaction->handle) != 0) {
       /* Generate an error. */
       rb_fireruby_raise(status, "Error committing transaction.");
     }
@@ -174,7 +175,7 @@ static VALUE rollbackTransaction(VALUE self) {
   if(transaction->handle != 0) {
     ISC_STATUS status[ISC_STATUS_LENGTH];
 
-    if(isc_rollback_transaction(status, &transaction->handle) != 0) {
+    if(rfb_rollback_transaction(status, &transaction->handle) != 0) {
       /* Generate an error. */
       rb_fireruby_raise(status, "Error rolling back transaction.");
     }
@@ -36,15 +36,18 @@
 #include "FireRuby.h"
 #include "rfbint.h"
 #include "rfbstr.h"
+#include "rfbgvl.h"
 
 /* Function prototypes. */
 VALUE createDate(const struct tm *);
-VALUE createDateTime(VALUE dt);
-VALUE createTime(VALUE dt);
-VALUE createSafeTime(const struct tm*);
-VALUE toDateTime(VALUE);
-VALUE rescueConvert(VALUE, VALUE);
+static VALUE createDateTime(const struct tm *, long);
+static VALUE createTimestamp(ISC_DATE, ISC_TIME);
+static void decodeDate(long, struct tm *);
+static short getLocalOffset(long long, long *);
+static short toTimestamp(VALUE, ISC_TIMESTAMP *);
 void storeBlob(VALUE, XSQLVAR *, ConnectionHandle *, TransactionHandle *);
+static VALUE writeBlobData(VALUE);
+static VALUE putBlobSegments(VALUE);
 void populateBlobField(VALUE, XSQLVAR *, VALUE, VALUE);
 void populateDoubleField(VALUE, XSQLVAR *);
 void populateFloatField(VALUE, XSQLVAR *);
@@ -55,34 +58,260 @@ void populateTextField(VALUE, XSQLVAR *);
 void populateDateField(VALUE, XSQLVAR *);
 void populateTimeField(VALUE, XSQLVAR *);
 void populateTimestampField(VALUE, XSQLVAR *);
+static ParameterBinder getParameterBinder(short);
 
 static ID 
   RB_INTERN_NEW,
   RB_INTERN_TO_F,
   RB_INTERN_ROUND,
   RB_INTERN_ASTERISK,
-  RB_INTERN_CLASS,
-  RB_INTERN_NAME;
+  RB_INTERN_BIG_DECIMAL,
+  RB_INTERN_TO_TIME,
+  RB_INTERN_MJD,
+  RB_INTERN_READ,
+  RB_INTERN_EACH;
   
-static VALUE cDate, cDateTime;
+static VALUE cDate, cDateTime, localOffset = Qnil;
+static short bigDecimalLoaded = 0;
+
+/* The Firebird date (a day count from November 17th, 1858) of January 1st,
+   1970. */
+#define ISC_DATE_UNIX_EPOCH  40587
+
+/* The number of seconds in a day. */
+#define SECONDS_PER_DAY      86400LL
+
+/* Powers of ten for the scales of NUMERIC and DECIMAL columns. */
+static const long long POWERS_OF_TEN[] = {1LL, 10LL, 100LL, 1000LL, 10000LL,
+                                          100000LL, 1000000LL, 10000000LL,
+                                          100000000LL, 1000000000LL,
+                                          10000000000LL, 100000000000LL,
+                                          1000000000000LL, 10000000000000LL,
+                                          100000000000000LL,
+                                          1000000000000000LL,
+                                          10000000000000000LL,
+                                          100000000000000000LL,
+                                          1000000000000000000LL};
+
+#ifndef INT32_MAX
+  #define INT32_MAX  2147483647
+  #define INT32_MIN  (-INT32_MAX - 1)
+#endif
+
+/* The size of the chunks read from IO blob data sources. */
+#define BLOB_CHUNK_SIZE  USHRT_MAX
+
+#ifndef RB_BLOCK_CALL_FUNC_ARGLIST
+  #define RB_BLOCK_CALL_FUNC_ARGLIST(yielded, data) VALUE yielded, VALUE data
+#endif
+
+/* The state of a blob being written by storeBlob. */
+typedef struct {
+  isc_blob_handle  handle;
+  ConnectionHandle *connection;
+  VALUE            source,
+                   chunk;
+} BlobWriter;
+
+/* The ways that scaled NUMERIC and DECIMAL values can be returned. */
+#define DECIMAL_AS_FLOAT        0
+#define DECIMAL_AS_BIG_DECIMAL  1
+#define DECIMAL_AS_RATIONAL     2
+#define DECIMAL_AS_INTEGER      3
+
+/* The DECIMAL_MODE setting values, indexed by the DECIMAL_AS_* values. */
+static VALUE decimalModes[4];
+
+/**
+ * This function determines how scaled values are to be returned from the
+ * DECIMAL_MODE setting, which may be :float (the default), :big_decimal,
+ * :rational or :integer. It is called when a statement is executed rather
+ * than for each value converted.
+ *
+ * @return  One of the DECIMAL_AS_* values.
+ *
+ */
+short getDecimalMode(void) {
+  VALUE setting = getFireRubySetting("DECIMAL_MODE");
+  short mode;
+
+  if(setting == Qnil) {
+    return(DECIMAL_AS_FLOAT);
+  }
+  for(mode = DECIMAL_AS_FLOAT; mode <= DECIMAL_AS_INTEGER; mode++) {
+    if(setting == decimalModes[mode]) {
+      return(mode);
+    }
+  }
+  rb_raise(rb_eArgError, "Invalid DECIMAL_MODE setting.");
+
+  return(DECIMAL_AS_FLOAT);
+}
+
+/**
+ * This function converts a decimal String to a scaled integer, rounding half
+ * away from zero any digits beyond the scale.
+ *
+ * @param  value   A reference to the String to be converted.
+ * @param  digits  The number of digits to keep after the decimal point.
+ * @param  result  A pointer to the long long to be assigned the result.
+ *
+ * @return  1 if the String was converted, 0 if it is not a plain decimal.
+ *
+ */
+static short parseDecimal(VALUE value, int digits, long long *result) {
+  const char *text     = RSTRING_PTR(value),
+             *end      = text + RSTRING_LEN(value);
+  long long  number    = 0;
+  short      negative  = 0,
+             point     = 0,
+             seen      = 0,
+             round     = 0;
+  int        fraction  = 0;
+
+  while(text < end && ISSPACE(*text)) {
+    text++;
+  }
+  while(end > text && ISSPACE(end[-1])) {
+    end--;
+  }
+  if(text < end && (*text == '-' || *text == '+')) {
+    negative = (*text++ == '-');
+  }
+  for(; text < end; text++) {
+    if(*text == '.' && !point) {
+      point = 1;
+    } else if(ISDIGIT(*text)) {
+      seen = 1;
+      if(point && fraction == digits) {
+        if(round == 0) {
+          round = (*text >= '5' ? 1 : -1);
+        }
+        continue;
+      }
+      if(number > (LLONG_MAX - (*text - '0')) / 10) {
+        rb_raise(rb_eRangeError, "Value %s out of range for column.",
+                 RSTRING_PTR(value));
+      }
+      number = number * 10 + (*text - '0');
+      fraction += point;
+    } else {
+      return(0);
+    }
+  }
+  if(!seen) {
+    return(0);
+  }
+
+  for(; fraction < digits; fraction++) {
+    if(number > LLONG_MAX / 10) {
+      rb_raise(rb_eRangeError, "Value %s out of range for column.",
+               RSTRING_PTR(value));
+    }
+    number *= 10;
+  }
+  number  += (round > 0);
+  *result  = (negative ? -number : number);
+
+  return(1);
+}
+
+/**
+ * This function checks that an integer value fits the storage of a parameter
+ * field before it is stored.
+ *
+ * @param  value    The value to be checked.
+ * @param  minimum  The smallest value the field can hold.
+ * @param  maximum  The largest value the field can hold.
+ *
+ * @return  The value checked.
+ *
+ */
+static long long checkRange(long long value, long long minimum,
+                            long long maximum) {
+  if(value < minimum || value > maximum) {
+    rb_raise(rb_eRangeError, "Value %lld out of range for column.", value);
+  }
+  return(value);
+}
 
 long long sql_scale(VALUE value, XSQLVAR *field) {
+  int       digits = abs(field->sqlscale);
+  long long result = 0;
+
+  if(digits >= (int)(sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]))) {
+    rb_raise(rb_eRangeError, "Unsupported column scale %d.", field->sqlscale);
+  }
+
+  if(FIXNUM_P(value) || TYPE(value) == T_BIGNUM) {
+    result = NUM2LL(value);
+    if(result > LLONG_MAX / POWERS_OF_TEN[digits] ||
+       result < LLONG_MIN / POWERS_OF_TEN[digits]) {
+      rb_raise(rb_eRangeError, "Value out of range for column.");
+    }
+    return(result * POWERS_OF_TEN[digits]);
+  }
+
+  if(TYPE(value) == T_FLOAT) {
+    double actual = round(NUM2DBL(value) * POWERS_OF_TEN[digits]);
+
+    if(actual >= 9223372036854775808.0 || actual < -9223372036854775808.0) {
+      rb_raise(rb_eRangeError, "Value out of range for column.");
+    }
+    return((long long)actual);
+  }
+
+  if(TYPE(value) == T_STRING && parseDecimal(value, digits, &result)) {
+    return(result);
+  }
+
+  if(TYPE(value) != T_STRING && rb_respond_to(value, RB_INTERN_ROUND)) {
+    /* Exact numerics such as BigDecimal and Rational. */
+    if(digits > 0) {
+      value = rb_funcall(value, RB_INTERN_ASTERISK, 1,
+                         LL2NUM(POWERS_OF_TEN[digits]));
+    }
+    return NUM2LL(rb_funcall(value, RB_INTERN_ROUND, 0));
+  }
+
   value = rb_funcall(value, RB_INTERN_TO_F, 0);
   if(field->sqlscale) {
     // this requires special care - decimal point shift can cause type overflow
     // the easyest way is to use ruby arithmetics (although it's not the fastes)
-    value = rb_funcall(value, RB_INTERN_ASTERISK, 1, LONG2NUM((long)pow(10, abs(field->sqlscale))));
+    value = rb_funcall(value, RB_INTERN_ASTERISK, 1, LL2NUM(POWERS_OF_TEN[digits]));
   }
   return NUM2LL(rb_funcall(value, RB_INTERN_ROUND, 0));
 }
 
-VALUE sql_unscale(VALUE value, XSQLVAR *field) {
+VALUE sql_unscale(long long value, XSQLVAR *field, short mode) {
+  int  digits = abs(field->sqlscale);
+  char text[32];
+
   if(field->sqlscale == 0) {
-    return value;
+    return LL2NUM(value);
   }
-  return rb_float_new(
-    NUM2DBL(rb_funcall(value, RB_INTERN_TO_F, 0)) / pow(10, abs(field->sqlscale))
-  );
+  if(digits >= (int)(sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]))) {
+    rb_raise(rb_eRangeError, "Unsupported column scale %d.", field->sqlscale);
+  }
+
+  switch(mode) {
+  case DECIMAL_AS_BIG_DECIMAL:
+    if(!bigDecimalLoaded) {
+      rb_require("bigdecimal");
+      bigDecimalLoaded = 1;
+    }
+    /* The BigDecimal is built from a scientific form of the integer value. */
+    snprintf(text, sizeof(text), "%lldE-%d", value, digits);
+    return rb_funcall(rb_mKernel, RB_INTERN_BIG_DECIMAL, 1, rb_str_new2(text));
+
+  case DECIMAL_AS_RATIONAL:
+    return rb_rational_new(LL2NUM(value), LL2NUM(POWERS_OF_TEN[digits]));
+
+  case DECIMAL_AS_INTEGER:
+    return LL2NUM(value);
+  }
+
+  return rb_float_new((double)value / POWERS_OF_TEN[digits]);
 }
 
 /**
@@ -90,6 +319,16 @@ VALUE sql_unscale(VALUE value, XSQLVAR *field) {
  *
  * @param  entry        A pointer to the SQLVAR type containing the data to be
  *                      converted.
+ * @param  encoding     The index of the Ruby encoding for text data, resolved
+ *                      from the entry character set when it was prepared.
+ * @param  intern       1 if text values are to be returned as frozen, interned
+ *                      Strings, 0 for new Strings.
+ * @param  trim         1 if the blanks padding CHAR values are to be removed,
+ *                      0 to return them at their declared width.
+ * @param  decimal      The DECIMAL_AS_* value for how scaled values are to be
+ *                      returned, as given by getDecimalMode.
+ * @param  inlining     The size in bytes up to which blobs are returned as
+ *                      Strings instead of Blob objects, 0 for no inlining.
  * @param  connection   The connection object relating to the data.
  * @param  transaction  The transaction handle relating to the data.
  *
@@ -98,7 +337,12 @@ VALUE sql_unscale(VALUE value, XSQLVAR *field) {
  *
  */
 VALUE toValue(XSQLVAR *entry,
-              VALUE connection, 
+              int encoding,
+              short intern,
+              short trim,
+              short decimal,
+              long inlining,
+              VALUE connection,
               VALUE transaction) {
   VALUE value = Qnil;
 
@@ -120,22 +364,24 @@ VALUE toValue(XSQLVAR *entry,
       memset(table, 0, 256);
       memcpy(column, entry->sqlname, entry->sqlname_length);
       memcpy(table, entry->relname, entry->relname_length);
-      blob = openBlob(entry, column, table, connection,
-                      transaction);
-      working = Data_Wrap_Struct(cBlob, NULL, blobFree, blob);
-      value = initializeBlob(working, connection);
+      blob = createBlob(entry, column, table, encoding);
+      if(inlining > 0) {
+        value = inlineBlob(blob, inlining, connection, transaction);
+      }
+      if(value == Qnil) {
+        working = Data_Wrap_Struct(cBlob, NULL, blobFree, blob);
+        value = initializeBlob(working, connection);
+        rb_iv_set(value, "@transaction", transaction);
+      }
       break;
 
     case SQL_TYPE_DATE:       /* Type: DATE */
-      memset(&datetime, 0, sizeof(struct tm));
-      isc_decode_sql_date((ISC_DATE *)entry->sqldata, &datetime);
-      datetime.tm_sec  = 0;
-      datetime.tm_min  = 0;
-      datetime.tm_hour = 0;
       if(getFireRubySetting("DATE_AS_DATE") == Qtrue) {
+        memset(&datetime, 0, sizeof(struct tm));
+        decodeDate(*((ISC_DATE *)entry->sqldata), &datetime);
         value = createDate(&datetime);
       } else {
-        value = createSafeTime(&datetime);
+        value = createTimestamp(*((ISC_DATE *)entry->sqldata), 0);
       }
       break;
 
@@ -148,37 +394,46 @@ VALUE toValue(XSQLVAR *entry,
       break;
 
     case SQL_INT64:       /* Type: DECIMAL, NUMERIC */
-      value =  sql_unscale(LL2NUM(*((long long *)entry->sqldata)), entry);
+      value =  sql_unscale(*((long long *)entry->sqldata), entry, decimal);
       break;
 
     case SQL_LONG:       /* Type: INTEGER, DECIMAL, NUMERIC */
-      value = sql_unscale(LONG2NUM(*((int32_t *)entry->sqldata)), entry);
+      value = sql_unscale(*((int32_t *)entry->sqldata), entry, decimal);
       break;
 
     case SQL_SHORT:       /* Type: SMALLINT, DECIMAL, NUMERIC */
-      value = sql_unscale(INT2NUM(*((short *)entry->sqldata)), entry);
+      value = sql_unscale(*((short *)entry->sqldata), entry, decimal);
       break;
 
     case SQL_TEXT:       /* Type: CHAR */
-      value = rfbstr(connection, entry->sqlsubtype, entry->sqldata, entry->sqllen);
+      length = entry->sqllen;
+      if(trim) {
+        length = rfbtrimlen(encoding, entry->sqldata, length);
+      }
+      if(intern) {
+        value = rfbinternstr(encoding, entry->sqldata, length);
+      } else {
+        value = rfbstr(encoding, entry->sqldata, length);
+      }
       break;
 
     case SQL_TYPE_TIME:       /* Type: TIME */
-      isc_decode_sql_time((ISC_TIME *)entry->sqldata, &datetime);
-      datetime.tm_year = 70;
-      datetime.tm_mon  = 0;
-      datetime.tm_mday = 1;
-      value = createSafeTime(&datetime);
+      value = createTimestamp(ISC_DATE_UNIX_EPOCH,
+                              *((ISC_TIME *)entry->sqldata));
       break;
 
     case SQL_TIMESTAMP:       /* Type: TIMESTAMP */
-      isc_decode_timestamp((ISC_TIMESTAMP *)entry->sqldata, &datetime);
-      value = createSafeTime(&datetime);
+      value = createTimestamp(((ISC_TIMESTAMP *)entry->sqldata)->timestamp_date,
+                              ((ISC_TIMESTAMP *)entry->sqldata)->timestamp_time);
       break;
 
     case SQL_VARYING:
       memcpy(&length, entry->sqldata, 2);
-      value = rfbstr(connection, entry->sqlsubtype, &entry->sqldata[2], length);
+      if(intern) {
+        value = rfbinternstr(encoding, &entry->sqldata[2], length);
+      } else {
+        value = rfbstr(encoding, &entry->sqldata[2], length);
+      }
       break;
     }   /* End of switch. */
   }
@@ -187,6 +442,191 @@ VALUE toValue(XSQLVAR *entry,
 }
 
 
+/**
+ * The following functions bind a non-nil Ruby value to a statement parameter
+ * of a particular type. One is chosen for each parameter when a statement is
+ * prepared, and values of the common Ruby types are stored directly without
+ * calling into Ruby.
+ *
+ * @param  value        A reference to the value to be bound.
+ * @param  field        A pointer to the parameter field to be populated.
+ * @param  transaction  A reference to the transaction the statement is to be
+ *                      executed in.
+ * @param  connection   A reference to the connection for the statement.
+ *
+ */
+static void bindArray(VALUE value, XSQLVAR *field, VALUE transaction,
+                      VALUE connection) {
+  rb_fireruby_raise(NULL, "Array parameters are not supported.");
+}
+
+static void bindBlob(VALUE value, XSQLVAR *field, VALUE transaction,
+                     VALUE connection) {
+  populateBlobField(value, field, transaction, connection);
+}
+
+static void bindDouble(VALUE value, XSQLVAR *field, VALUE transaction,
+                       VALUE connection) {
+  if(TYPE(value) == T_FLOAT) {
+    *((double *)field->sqldata) = RFLOAT_VALUE(value);
+    field->sqltype = SQL_DOUBLE;
+  } else if(FIXNUM_P(value)) {
+    *((double *)field->sqldata) = (double)FIX2LONG(value);
+    field->sqltype = SQL_DOUBLE;
+  } else {
+    populateDoubleField(value, field);
+  }
+}
+
+static void bindFloat(VALUE value, XSQLVAR *field, VALUE transaction,
+                      VALUE connection) {
+  if(TYPE(value) == T_FLOAT) {
+    *((float *)field->sqldata) = (float)RFLOAT_VALUE(value);
+    field->sqltype = SQL_FLOAT;
+  } else if(FIXNUM_P(value)) {
+    *((float *)field->sqldata) = (float)FIX2LONG(value);
+    field->sqltype = SQL_FLOAT;
+  } else {
+    populateFloatField(value, field);
+  }
+}
+
+static void bindInt64(VALUE value, XSQLVAR *field, VALUE transaction,
+                      VALUE connection) {
+  if(FIXNUM_P(value) && field->sqlscale == 0) {
+    *((long long *)field->sqldata) = FIX2LONG(value);
+    field->sqltype = SQL_INT64;
+  } else {
+    populateInt64Field(value, field);
+  }
+}
+
+static void bindLong(VALUE value, XSQLVAR *field, VALUE transaction,
+                     VALUE connection) {
+  if(FIXNUM_P(value) && field->sqlscale == 0) {
+    *((int32_t *)field->sqldata) = (int32_t)checkRange(FIX2LONG(value),
+                                                       INT32_MIN, INT32_MAX);
+    field->sqltype = SQL_LONG;
+  } else {
+    populateLongField(value, field);
+  }
+}
+
+static void bindShort(VALUE value, XSQLVAR *field, VALUE transaction,
+                      VALUE connection) {
+  if(FIXNUM_P(value) && field->sqlscale == 0) {
+    *((short *)field->sqldata) = (short)checkRange(FIX2LONG(value),
+                                                   SHRT_MIN, SHRT_MAX);
+    field->sqltype = SQL_SHORT;
+  } else {
+    populateShortField(value, field);
+  }
+}
+
+static void bindText(VALUE value, XSQLVAR *field, VALUE transaction,
+                     VALUE connection) {
+  populateTextField(value, field);
+}
+
+static void bindDate(VALUE value, XSQLVAR *field, VALUE transaction,
+                     VALUE connection) {
+  populateDateField(value, field);
+}
+
+static void bindTime(VALUE value, XSQLVAR *field, VALUE transaction,
+                     VALUE connection) {
+  populateTimeField(value, field);
+}
+
+static void bindTimestamp(VALUE value, XSQLVAR *field, VALUE transaction,
+                          VALUE connection) {
+  populateTimestampField(value, field);
+}
+
+static void bindUnknown(VALUE value, XSQLVAR *field, VALUE transaction,
+                        VALUE connection) {
+  rb_raise(rb_eException,
+           "Unknown SQL type encountered in statement parameter set.");
+}
+
+
+/**
+ * This function selects the function used to bind values to a parameter of a
+ * given SQL type.
+ *
+ * @param  type  The SQL type of the parameter.
+ *
+ * @return  A pointer to the binding function for the type.
+ *
+ */
+static ParameterBinder getParameterBinder(short type) {
+  switch(type & ~1) {
+  case SQL_ARRAY:         /* Type: ARRAY */
+    return(bindArray);
+
+  case SQL_BLOB:          /* Type: BLOB */
+    return(bindBlob);
+
+  case SQL_DOUBLE:        /* Type: DOUBLE PRECISION, DECIMAL, NUMERIC */
+    return(bindDouble);
+
+  case SQL_FLOAT:         /* Type: FLOAT */
+    return(bindFloat);
+
+  case SQL_INT64:         /* Type: DECIMAL, NUMERIC */
+    return(bindInt64);
+
+  case SQL_LONG:          /* Type: INTEGER, DECIMAL, NUMERIC */
+    return(bindLong);
+
+  case SQL_SHORT:         /* Type: SMALLINT, DECIMAL, NUMERIC */
+    return(bindShort);
+
+  case SQL_TEXT:          /* Type: CHAR */
+  case SQL_VARYING:       /* Type: VARCHAR */
+    return(bindText);
+
+  case SQL_TYPE_DATE:     /* Type: DATE */
+    return(bindDate);
+
+  case SQL_TYPE_TIME:     /* Type: TIME */
+    return(bindTime);
+
+  case SQL_TIMESTAMP:     /* Type: TIMESTAMP */
+    return(bindTimestamp);
+  }
+
+  return(bindUnknown);
+}
+
+
+/**
+ * This function records the type and length of each of the parameters in a
+ * XSQLDA as described by the database, so that the XSQLDA can be reused for
+ * several executions of a statement, along with the function used to bind
+ * values to each parameter.
+ *
+ * @param  parameters  A pointer to the described XSQLDA.
+ *
+ * @return  A pointer to an array of ParameterInfo structures, one for each of
+ *          the parameters in the XSQLDA. The caller is responsible for
+ *          releasing the array.
+ *
+ */
+ParameterInfo *describeParameters(XSQLDA *parameters) {
+  ParameterInfo *info = ALLOC_N(ParameterInfo, parameters->sqld);
+  int index;
+
+  for(index = 0; index < parameters->sqld; index++) {
+    info[index].type   = parameters->sqlvar[index].sqltype;
+    info[index].length = parameters->sqlvar[index].sqllen;
+    info[index].binder = getParameterBinder(info[index].type);
+  }
+
+  return(info);
+}
+
+
 /**
  * This function takes an array of parameters and populates the parameter set
  * for a Statement object with the details. Attempts are made to convert the
@@ -195,13 +635,19 @@ VALUE toValue(XSQLVAR *entry,
  *
  * @param  parameters  A pointer to the XSQLDA area that will be used to
  *                     hold the parameter data.
+ * @param  info        A pointer to the parameter descriptions recorded for the
+ *                     XSQLDA by describeParameters. The type and length of
+ *                     each parameter are reset from these before it is
+ *                     populated, as populating a parameter alters them, and
+ *                     the parameter is populated by the recorded binder.
  * @param  array       A reference to an array containing the parameter data to
  *                     be used.
  * @param  source      Either a Statement or ResultSet object that can be used
  *                     to get connection and transaction details.
  *
  */
-void setParameters(XSQLDA *parameters, VALUE array, VALUE transaction, VALUE connection) {
+void setParameters(XSQLDA *parameters, ParameterInfo *info, VALUE array,
+                   VALUE transaction, VALUE connection) {
   long index,
        size;
   XSQLVAR *parameter = NULL;
@@ -218,70 +664,16 @@ void setParameters(XSQLDA *parameters, VALUE array, VALUE transaction, VALUE con
   parameters->version = 1;
 
   /* Populate the parameters from the array's contents. */
-  for(index = 0; index < size; index++, parameter++) {
-    int type = (parameter->sqltype & ~1);
+  for(index = 0; index < size; index++, parameter++, info++) {
     VALUE value = rb_ary_entry(array, index);
 
+    parameter->sqltype = info->type;
+    parameter->sqllen  = info->length;
+
     /* Check for nils to indicate null values. */
     if(value != Qnil) {
-      VALUE name = rb_funcall(value, RB_INTERN_CLASS, 0);
-
       *parameter->sqlind = 0;
-      name = rb_funcall(name, RB_INTERN_NAME, 0);
-      switch(type) {
-      case SQL_ARRAY:        /* Type: ARRAY */
-        /* TO BE DONE! */
-        break;
-
-      case SQL_BLOB:         /* Type: BLOB */
-        populateBlobField(value, parameter, transaction, connection);
-        break;
-
-      case SQL_DOUBLE:        /* Type: DOUBLE PRECISION, DECIMAL, NUMERIC */
-        populateDoubleField(value, parameter);
-        break;
-
-      case SQL_FLOAT:        /* Type: FLOAT */
-        populateFloatField(value, parameter);
-        break;
-
-      case SQL_INT64:        /* Type: DECIMAL, NUMERIC */
-        populateInt64Field(value, parameter);
-        break;
-
-      case SQL_LONG:        /* Type: INTEGER, DECIMAL, NUMERIC */
-        populateLongField(value, parameter);
-        break;
-
-      case SQL_SHORT:        /* Type: SMALLINT, DECIMAL, NUMERIC */
-        populateShortField(value, parameter);
-        break;
-
-      case SQL_TEXT:        /* Type: CHAR */
-        populateTextField(value, parameter);
-        break;
-
-      case SQL_TYPE_DATE:        /* Type: DATE */
-        populateDateField(value, parameter);
-        break;
-
-      case SQL_TYPE_TIME:        /* Type: TIME */
-        populateTimeField(value, parameter);
-        break;
-
-      case SQL_TIMESTAMP:        /* Type: TIMESTAMP */
-        populateTimestampField(value, parameter);
-        break;
-
-      case SQL_VARYING:        /* Type: VARCHAR */
-        populateTextField(value, parameter);
-        break;
-
-      default:
-        rb_raise(rb_eException,
-                 "Unknown SQL type encountered in statement parameter " \
-                 "set.");
-      }    /* End of the switch statement. */
+      info->binder(value, parameter, transaction, connection);
     } else {
       /* Mark the field as a NULL value. */
       memset(parameter->sqldata, 0, parameter->sqllen);
@@ -305,160 +697,297 @@ VALUE createDate(const struct tm *date) {
 
 
 /**
- * This function converts a struct tm to a Ruby DateTime instance.
+ * This function converts a struct tm to a Ruby DateTime instance in the local
+ * time zone. It is used for values that are out of range for a Ruby Time.
  *
  * @param  datetime  A structure containing the date/time details.
+ * @param  fraction  The fraction of the second, in ten thousandths.
  *
  * @return  A Ruby DateTime object.
  *
  */
-VALUE createDateTime(VALUE dt) {
-  struct tm *datetime;
-  Data_Get_Struct(dt, struct tm, datetime);
+static VALUE createDateTime(const struct tm *datetime, long fraction) {
+  VALUE seconds = INT2FIX(datetime->tm_sec);
 
-  return rb_funcall(cDateTime, RB_INTERN_NEW, 7, 
+  if(localOffset == Qnil) {
+    localOffset = rb_funcall(rb_funcall(cDateTime, rb_intern("now"), 0),
+                             rb_intern("offset"), 0);
+  }
+  if(fraction != 0) {
+    seconds = rb_rational_new(LONG2FIX(datetime->tm_sec *
+                                       ISC_TIME_SECONDS_PRECISION + fraction),
+                              INT2FIX(ISC_TIME_SECONDS_PRECISION));
+  }
+
+  return rb_funcall(cDateTime, RB_INTERN_NEW, 7,
     INT2FIX(datetime->tm_year + 1900),
     INT2FIX(datetime->tm_mon + 1),
     INT2FIX(datetime->tm_mday),
     INT2FIX(datetime->tm_hour),
     INT2FIX(datetime->tm_min),
-    INT2FIX(datetime->tm_sec),
-    rb_funcall(rb_funcall(cDateTime, rb_intern("now"), 0), rb_intern("offset"), 0)
+    seconds,
+    localOffset
   );
 }
 
 
 /**
- * This function converts a struct tm to a Ruby Time instance.
+ * This function converts a Firebird date, a count of days from November 17th,
+ * 1858, to the year, month and day of month fields of a struct tm.
  *
- * @param  datetime  A structure containing the date/time details.
+ * @param  date      The Firebird date to be converted.
+ * @param  datetime  A pointer to the structure to be filled in.
+ *
+ */
+static void decodeDate(long date, struct tm *datetime) {
+  long days = date - ISC_DATE_UNIX_EPOCH + 719468,
+       era  = (days >= 0 ? days : days - 146096) / 146097,
+       day  = days - era * 146097,
+       year = (day - day / 1460 + day / 36524 - day / 146096) / 365,
+       yday = day - (365 * year + year / 4 - year / 100),
+       mon  = (5 * yday + 2) / 153;
+
+  datetime->tm_mday = yday - (153 * mon + 2) / 5 + 1;
+  datetime->tm_mon  = (mon < 10 ? mon + 2 : mon - 10);
+  datetime->tm_year = year + era * 400 + (datetime->tm_mon < 2) - 1900;
+}
+
+
+/**
+ * This function determines the offset of the local time zone from UTC for a
+ * local wall clock time. Offsets are cached by the hour, as consecutive values
+ * are usually close together, so the C library is rarely consulted.
+ *
+ * @param  wall    The wall clock time, as seconds from the Unix epoch.
+ * @param  offset  A pointer to a long that will be assigned the offset in
+ *                 seconds east of UTC.
  *
- * @return  A Ruby Time object.
+ * @return  1 if the offset was determined, 0 if the time can't be represented
+ *          by the C library.
  *
  */
-VALUE createTime(VALUE dt) {
-  struct tm *datetime;
-  Data_Get_Struct(dt, struct tm, datetime);
+static short getLocalOffset(long long wall, long *offset) {
+  static long long cachedHour   = LLONG_MIN;
+  static long      cachedOffset = 0;
+  long long        days         = wall / SECONDS_PER_DAY,
+                   hour;
+
+  if(wall % SECONDS_PER_DAY < 0) {
+    days--;
+  }
+  hour = wall / 3600 - (wall % 3600 < 0 ? 1 : 0);
 
-  /*fprintf(stderr, "%d-%d-%d %d:%d:%d\n", datetime->tm_year + 1900,
-          datetime->tm_mon + 1, datetime->tm_mday, datetime->tm_hour,
-          datetime->tm_min, datetime->tm_sec);*/
+  if(hour != cachedHour) {
+    struct tm datetime;
+    long      seconds = (long)(wall - days * SECONDS_PER_DAY);
+    time_t    actual;
 
-  /* Create the class instance. */
-  return rb_funcall(rb_cTime, rb_intern("local"), 6, 
-    INT2FIX(datetime->tm_year + 1900),
-    INT2FIX(datetime->tm_mon + 1),
-    INT2FIX(datetime->tm_mday),
-    INT2FIX(datetime->tm_hour),
-    INT2FIX(datetime->tm_min),
-    INT2FIX(datetime->tm_sec)
-  );
+    if(sizeof(time_t) < 8 &&
+       (wall < INT_MIN + SECONDS_PER_DAY || wall > INT_MAX - SECONDS_PER_DAY)) {
+      return(0);
+    }
+
+    memset(&datetime, 0, sizeof(struct tm));
+    decodeDate((long)(days + ISC_DATE_UNIX_EPOCH), &datetime);
+    datetime.tm_hour  = seconds / 3600;
+    datetime.tm_min   = (seconds / 60) % 60;
+    datetime.tm_sec   = seconds % 60;
+    datetime.tm_isdst = -1;
+    actual = mktime(&datetime);
+    if(actual == (time_t)-1 && wall != -1) {
+      return(0);
+    }
+    cachedOffset = (long)(wall - actual);
+    cachedHour   = hour;
+  }
+  *offset = cachedOffset;
+
+  return(1);
 }
 
+
 /**
- * This function converts a struct tm to a Ruby Time instance.
- * If the conversion process results in an out of range error then
- * it will convert the struct to a DateTime instance.
+ * This function converts a Firebird date and time of day to a Ruby Time in
+ * the local time zone, keeping the fraction of the second. Values that are
+ * out of range for the platform are converted to a DateTime instead.
  *
- * @param datetime  A structure containing the date/time details.
+ * @param  date  The Firebird date, in days from November 17th, 1858.
+ * @param  time  The Firebird time of day, in ten thousandths of a second.
  *
- * @return  A Ruby Time object if the arguments are in range, otherwise
- *          a Ruby DateTime object.
+ * @return  A Ruby Time object, or a DateTime object for out of range values.
  *
  */
-VALUE createSafeTime(const struct tm *datetime) {
-  VALUE dt = Data_Wrap_Struct(rb_cObject, NULL, NULL, (void*)datetime);
-  return rb_rescue(createTime, dt, createDateTime, dt);
+static VALUE createTimestamp(ISC_DATE date, ISC_TIME time) {
+  long      seconds  = time / ISC_TIME_SECONDS_PRECISION,
+            fraction = time % ISC_TIME_SECONDS_PRECISION,
+            offset   = 0;
+  long long wall     = (long long)(date - ISC_DATE_UNIX_EPOCH) * SECONDS_PER_DAY +
+                       seconds;
+  struct tm datetime;
+
+  if(getLocalOffset(wall, &offset)) {
+    return(rb_time_nano_new((time_t)(wall - offset),
+                            fraction * (1000000000 / ISC_TIME_SECONDS_PRECISION)));
+  }
+
+  memset(&datetime, 0, sizeof(struct tm));
+  decodeDate(date, &datetime);
+  datetime.tm_hour = seconds / 3600;
+  datetime.tm_min  = (seconds / 60) % 60;
+  datetime.tm_sec  = seconds % 60;
+
+  return(createDateTime(&datetime, fraction));
 }
 
 /**
- * This function attempts to convert a VALUE to a series of date/time values.
+ * This function converts a Ruby Time, DateTime or Date to a Firebird date and
+ * time of day, using the wall clock time in the zone of the value. Times are
+ * read directly, keeping the fraction of the second, and Dates through a
+ * single call for their modified Julian day number.
  *
- * @param  value  A reference to the value to be converted.
+ * @param  value      A reference to the value to be converted.
+ * @param  timestamp  A pointer to the structure to be filled in.
  *
- * @return  A VALUE that represents an array containing the date/time details
- *          in the order year, month, day of month, hours, minutes and seconds.
+ * @return  1 if the value was converted, 0 if it isn't a date or time.
  *
  */
-VALUE toDateTime(VALUE value) {
-  VALUE result,
-        klass = rb_funcall(value, RB_INTERN_CLASS, 0);
+static short toTimestamp(VALUE value, ISC_TIMESTAMP *timestamp) {
+  if(rb_obj_is_kind_of(value, cDateTime)) {
+    value = rb_funcall(value, RB_INTERN_TO_TIME, 0);
+  }
 
-  if((klass == rb_cTime) || (klass == cDateTime)) {
-    VALUE data;
+  if(rb_obj_is_kind_of(value, rb_cTime)) {
+    struct timespec actual = rb_time_timespec(value);
+    long long       wall   = (long long)actual.tv_sec +
+                             NUM2LONG(rb_time_utc_offset(value)),
+                    days   = wall / SECONDS_PER_DAY;
 
-    if (klass == cDateTime) {
-      value = rb_funcall(value, rb_intern("to_time"), 0);
+    if(wall % SECONDS_PER_DAY < 0) {
+      days--;
     }
-    result = rb_ary_new();
-
-    data = rb_funcall(value, rb_intern("year"), 0);
-    rb_ary_push(result, INT2FIX(FIX2INT(data) - 1900));
-    data = rb_funcall(value, rb_intern("month"), 0);
-    rb_ary_push(result, INT2FIX(FIX2INT(data) - 1));
-    rb_ary_push(result, rb_funcall(value, rb_intern("day"), 0));
-    rb_ary_push(result, rb_funcall(value, rb_intern("hour"), 0));
-    rb_ary_push(result, rb_funcall(value, rb_intern("min"), 0));
-    rb_ary_push(result, rb_funcall(value, rb_intern("sec"), 0));
-  } else if(klass == cDate) {
-    VALUE data;
-
-    result = rb_ary_new();
-
-    data = rb_funcall(value, rb_intern("year"), 0);
-    rb_ary_push(result, INT2FIX(FIX2INT(data) - 1900));
-    data = rb_funcall(value, rb_intern("month"), 0);
-    rb_ary_push(result, INT2FIX(FIX2INT(data) - 1));
-    rb_ary_push(result, rb_funcall(value, rb_intern("mday"), 0));
-    rb_ary_push(result, INT2FIX(0));
-    rb_ary_push(result, INT2FIX(0));
-    rb_ary_push(result, INT2FIX(0));
-  } else {
-    rb_raise(rb_eException, "Value conversion error.");
+    timestamp->timestamp_date = (ISC_DATE)(days + ISC_DATE_UNIX_EPOCH);
+    timestamp->timestamp_time = (ISC_TIME)((wall - days * SECONDS_PER_DAY) *
+                                           ISC_TIME_SECONDS_PRECISION +
+                                           actual.tv_nsec /
+                                           (1000000000 / ISC_TIME_SECONDS_PRECISION));
+    return(1);
+  }
+
+  if(rb_obj_is_kind_of(value, cDate)) {
+    timestamp->timestamp_date = NUM2INT(rb_funcall(value, RB_INTERN_MJD, 0));
+    timestamp->timestamp_time = 0;
+    return(1);
   }
 
-  return(result);
+  return(0);
+}
+
+/**
+ * This function writes the contents of a String to a blob in segments. The
+ * lock on the client library is released while each segment is written.
+ *
+ * @param  writer  A pointer to the BlobWriter for the blob.
+ * @param  data    A reference to the String to be written.
+ *
+ */
+static void putBlobString(BlobWriter *writer, VALUE data) {
+  StringValue(data);
+  writer->chunk = data;
+
+  /* The string must not change while the lock is released, and is unlocked
+     however the write ends. */
+  rb_str_locktmp(data);
+  rb_ensure(putBlobSegments, (VALUE)writer, rb_str_unlocktmp, data);
 }
 
 
 /**
- * This function represents the rescue block for data conversions.
+ * This function writes the segments of the String held in a BlobWriter, for
+ * putBlobString.
  *
- * @param  arguments  An array of VALUEs. The first is expected to contain the
- *                    field offset of the value being converted. The second a
- *                    string containing the name of the data type being
- *                    converted from and the third a string containing the name
- *                    of the data type being converted to.
- * @param  error      Will be populates with error details of the exception
- *                    raised.
+ * @param  data  A pointer to the BlobWriter for the blob, cast to a VALUE.
+ *
+ * @return  Qnil
  *
  */
-VALUE rescueConvert(VALUE arguments, VALUE error) {
-  VALUE message,
-        tmp_str1 = Qnil,
-        tmp_str2 = Qnil;
-  char text[512];
+static VALUE putBlobSegments(VALUE data) {
+  BlobWriter *writer = (BlobWriter *)data;
+  ISC_STATUS status[ISC_STATUS_LENGTH];
+  long       offset  = 0,
+             length  = RSTRING_LEN(writer->chunk);
 
-  tmp_str1 = rb_ary_entry(arguments, 1);
-  tmp_str2 = rb_ary_entry(arguments, 2);
-  sprintf(text, "Error converting input column %d from a %s to a %s.",
-          FIX2INT(rb_ary_entry(arguments, 0)),
-          StringValuePtr(tmp_str1),
-          StringValuePtr(tmp_str2));
-  message = rb_str_new2(text);
+  while(offset < length) {
+    unsigned short size = (length - offset) > USHRT_MAX ?
+                          USHRT_MAX : length - offset;
+
+    if(rfb_put_segment(status, &writer->handle, size,
+                       &RSTRING_PTR(writer->chunk)[offset],
+                       &writer->connection->handle) != 0) {
+      rb_fireruby_raise(status, "Error writing blob data.");
+    }
+    offset = offset + size;
+    rb_thread_check_ints();
+  }
 
-  return(rb_funcall(rb_eException, rb_intern("exception"), 1, &message));
+  return(Qnil);
 }
 
-long getLongProperty(VALUE obj, const char* name) {
-  VALUE number  = rb_funcall(obj, rb_intern(name), 0);
-  return TYPE(number) == T_FIXNUM ? FIX2INT(number) : NUM2INT(number);
+
+/**
+ * This function is called for each chunk of data yielded by the each method
+ * of a blob data source.
+ *
+ * @param  chunk   A reference to the String chunk to be written.
+ * @param  writer  A pointer to the BlobWriter for the blob, cast to a VALUE.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE putBlobChunk(RB_BLOCK_CALL_FUNC_ARGLIST(chunk, writer)) {
+  putBlobString((BlobWriter *)writer, chunk);
+  return(Qnil);
 }
 
+
+/**
+ * This function writes the data for a blob from its source, which may be a
+ * String, an object responding to read (such as a File or StringIO) that is
+ * read in BLOB_CHUNK_SIZE chunks, or an Enumerator that yields String chunks.
+ * Only one chunk is held in memory at a time.
+ *
+ * @param  data  A pointer to the BlobWriter for the blob, cast to a VALUE.
+ *
+ * @return  Qnil
+ *
+ */
+static VALUE writeBlobData(VALUE data) {
+  BlobWriter *writer = (BlobWriter *)data;
+  VALUE      source  = writer->source;
+
+  if(TYPE(source) == T_STRING) {
+    putBlobString(writer, source);
+  } else if(rb_respond_to(source, RB_INTERN_READ)) {
+    VALUE chunk = rb_funcall(source, RB_INTERN_READ, 1,
+                             INT2FIX(BLOB_CHUNK_SIZE));
+
+    while(chunk != Qnil && RSTRING_LEN(StringValue(chunk)) > 0) {
+      putBlobString(writer, chunk);
+      chunk = rb_funcall(source, RB_INTERN_READ, 1, INT2FIX(BLOB_CHUNK_SIZE));
+    }
+  } else {
+    rb_block_call(source, RB_INTERN_EACH, 0, NULL, putBlobChunk, data);
+  }
+
+  return(Qnil);
+}
+
+
 /**
  * This function creates a new blob and returns the identifier for it.
  *
- * @param  info         A pointer to a string containing the blob data.
+ * @param  info         A reference to the blob data, either a String, an
+ *                      object responding to read or an object responding to
+ *                      each that yields String chunks.
  * @param  field        The field that the blob identifier needs to be inserted
  *                      into.
  * @param  database     A pointer to the database handle to be used in creating
@@ -474,42 +1003,31 @@ void storeBlob(VALUE info,
                ConnectionHandle *connection,
                TransactionHandle *transaction) {
   ISC_STATUS status[ISC_STATUS_LENGTH];
-  isc_blob_handle handle  = 0;
-  ISC_QUAD        *blobId = (ISC_QUAD *)field->sqldata;
-  char *data   = StringValuePtr(info);
-  long dataLength = getLongProperty(info, "length");
-
-  if(Qtrue == rb_funcall(info, rb_intern("respond_to?"), 1, ID2SYM(rb_intern("bytesize")))) {
-    /* 1.9 strings */
-    dataLength = getLongProperty(info, "bytesize");
-  }
-
+  ISC_QUAD   *blobId = (ISC_QUAD *)field->sqldata;
+  BlobWriter writer;
+  int        state = 0;
+
+  writer.handle     = 0;
+  writer.connection = connection;
+  writer.source     = info;
+  writer.chunk      = Qnil;
   field->sqltype = SQL_BLOB;
 
   if(isc_create_blob(status, &connection->handle, &transaction->handle,
-                     &handle, blobId) == 0) {
-    long offset = 0;
-    unsigned short size   = 0;
-
-    while(offset < dataLength) {
-      char *buffer = &data[offset];
-
-      size = (dataLength - offset) > USHRT_MAX ? USHRT_MAX : dataLength - offset;
-      if(isc_put_segment(status, &handle, size, buffer) != 0) {
-        ISC_STATUS other[20];
+                     &writer.handle, blobId) != 0) {
+    rb_fireruby_raise(status, "Error storing blob data.");
+  }
 
-        isc_close_blob(other, &handle);
-        rb_fireruby_raise(status, "Error writing blob data.");
-      }
+  rb_protect(writeBlobData, (VALUE)&writer, &state);
+  if(state) {
+    ISC_STATUS other[ISC_STATUS_LENGTH];
 
-      offset = offset + size;
-    }
+    isc_cancel_blob(other, &writer.handle);
+    rb_jump_tag(state);
+  }
 
-    if(isc_close_blob(status, &handle) != 0) {
-      rb_fireruby_raise(status, "Error closing blob.");
-    }
-  } else {
-    rb_fireruby_raise(status, "Error storing blob data.");
+  if(isc_close_blob(status, &writer.handle) != 0) {
+    rb_fireruby_raise(status, "Error closing blob.");
   }
 }
 
@@ -527,7 +1045,8 @@ void populateBlobField(VALUE value, XSQLVAR *field, VALUE transaction, VALUE con
   ConnectionHandle  *hConnection = NULL;
   TransactionHandle *hTransaction = NULL;
 
-  if(TYPE(value) != T_STRING) {
+  if(TYPE(value) != T_STRING && !rb_respond_to(value, RB_INTERN_READ) &&
+     !RTEST(rb_obj_is_kind_of(value, rb_cEnumerator))) {
     rb_fireruby_raise(NULL, "Error converting input parameter to blob.");
   }
 
@@ -547,19 +1066,12 @@ void populateBlobField(VALUE value, XSQLVAR *field, VALUE transaction, VALUE con
  *
  */
 void populateDateField(VALUE value, XSQLVAR *field) {
-  struct tm datetime;
-  VALUE arguments = rb_ary_new();
-
-  rb_ary_push(arguments, rb_str_new2("date"));
-  value = rb_rescue(toDateTime, value, rescueConvert, arguments);
-  if(TYPE(value) != T_ARRAY) {
-    VALUE message = rb_funcall(value, rb_intern("message"), 0);
-    rb_fireruby_raise(NULL, StringValuePtr(message));
-  }
-  datetime.tm_year = FIX2INT(rb_ary_entry(value, 0));
-  datetime.tm_mon  = FIX2INT(rb_ary_entry(value, 1));
-  datetime.tm_mday = FIX2INT(rb_ary_entry(value, 2));
-  isc_encode_sql_date(&datetime, (ISC_DATE *)field->sqldata);
+  ISC_TIMESTAMP timestamp = {0, 0};
+
+  if(!toTimestamp(value, &timestamp)) {
+    rb_fireruby_raise(NULL, "Error converting input parameter to date.");
+  }
+  *((ISC_DATE *)field->sqldata) = timestamp.timestamp_date;
   field->sqltype   = SQL_TYPE_DATE;
 }
 
@@ -573,11 +1085,10 @@ void populateDateField(VALUE value, XSQLVAR *field) {
  */
 void populateDoubleField(VALUE value, XSQLVAR *field) {
   double store;
-  VALUE actual;
 
   if(TYPE(value) != T_FLOAT) {
     if(rb_obj_is_kind_of(value, rb_cNumeric) || TYPE(value) == T_STRING) {
-      actual = rb_funcall(value, RB_INTERN_TO_F, 0);
+      value = rb_funcall(value, RB_INTERN_TO_F, 0);
     } else {
       rb_fireruby_raise(NULL,
                         "Error converting input parameter to double.");
@@ -600,11 +1111,10 @@ void populateDoubleField(VALUE value, XSQLVAR *field) {
 void populateFloatField(VALUE value, XSQLVAR *field) {
   double full  = 0.0;
   float store = 0.0;
-  VALUE actual;
 
   if(TYPE(value) != T_FLOAT) {
     if(rb_obj_is_kind_of(value, rb_cNumeric) || TYPE(value) == T_STRING) {
-      actual = rb_funcall(value, RB_INTERN_TO_F, 0);
+      value = rb_funcall(value, RB_INTERN_TO_F, 0);
     } else {
       rb_fireruby_raise(NULL,
                         "Error converting input parameter to double.");
@@ -641,7 +1151,8 @@ void populateInt64Field(VALUE value, XSQLVAR *field) {
  *
  */
 void populateLongField(VALUE value, XSQLVAR *field) {
-  *((long *)field->sqldata) = sql_scale(value, field);
+  *((int32_t *)field->sqldata) = (int32_t)checkRange(sql_scale(value, field),
+                                                     INT32_MIN, INT32_MAX);
   field->sqltype = SQL_LONG;
 }
 
@@ -655,7 +1166,8 @@ void populateLongField(VALUE value, XSQLVAR *field) {
  *
  */
 void populateShortField(VALUE value, XSQLVAR *field) {
-  *((short *)field->sqldata) = sql_scale(value, field);
+  *((short *)field->sqldata) = (short)checkRange(sql_scale(value, field),
+                                                 SHRT_MIN, SHRT_MAX);
   field->sqltype = SQL_SHORT;
 }
 
@@ -702,19 +1214,12 @@ void populateTextField(VALUE value, XSQLVAR *field) {
  *
  */
 void populateTimeField(VALUE value, XSQLVAR *field) {
-  struct tm datetime;
-  VALUE arguments = rb_ary_new();
-
-  rb_ary_push(arguments, rb_str_new2("time"));
-  value = rb_rescue(toDateTime, value, rescueConvert, arguments);
-  if(TYPE(value) != T_ARRAY) {
-    VALUE message = rb_funcall(value, rb_intern("message"), 0);
-    rb_fireruby_raise(NULL, StringValuePtr(message));
-  }
-  datetime.tm_hour = FIX2INT(rb_ary_entry(value, 3));
-  datetime.tm_min  = FIX2INT(rb_ary_entry(value, 4));
-  datetime.tm_sec  = FIX2INT(rb_ary_entry(value, 5));
-  isc_encode_sql_time(&datetime, (ISC_TIME *)field->sqldata);
+  ISC_TIMESTAMP timestamp = {0, 0};
+
+  if(!toTimestamp(value, &timestamp)) {
+    rb_fireruby_raise(NULL, "Error converting input parameter to time.");
+  }
+  *((ISC_TIME *)field->sqldata) = timestamp.timestamp_time;
   field->sqltype   = SQL_TYPE_TIME;
 }
 
@@ -726,22 +1231,9 @@ void populateTimeField(VALUE value, XSQLVAR *field) {
  *
  */
 void populateTimestampField(VALUE value, XSQLVAR *field) {
-  struct tm datetime;
-  VALUE arguments = rb_ary_new();
-
-  rb_ary_push(arguments, rb_str_new2("timestamp"));
-  value = rb_rescue(toDateTime, value, rescueConvert, arguments);
-  if(TYPE(value) != T_ARRAY) {
-    VALUE message = rb_funcall(value, rb_intern("message"), 0);
-    rb_fireruby_raise(NULL, StringValuePtr(message));
-  }
-  datetime.tm_year = FIX2INT(rb_ary_entry(value, 0));
-  datetime.tm_mon  = FIX2INT(rb_ary_entry(value, 1));
-  datetime.tm_mday = FIX2INT(rb_ary_entry(value, 2));
-  datetime.tm_hour = FIX2INT(rb_ary_entry(value, 3));
-  datetime.tm_min  = FIX2INT(rb_ary_entry(value, 4));
-  datetime.tm_sec  = FIX2INT(rb_ary_entry(value, 5));
-  isc_encode_timestamp(&datetime, (ISC_TIMESTAMP *)field->sqldata);
+  if(!toTimestamp(value, (ISC_TIMESTAMP *)field->sqldata)) {
+    rb_fireruby_raise(NULL, "Error converting input parameter to timestamp.");
+  }
   field->sqltype   = SQL_TIMESTAMP;
 }
 
@@ -750,9 +1242,17 @@ void Init_TypeMap(VALUE module) {
   RB_INTERN_TO_F = rb_intern("to_f");
   RB_INTERN_ROUND = rb_intern("round");
   RB_INTERN_ASTERISK = rb_intern("*");
-  RB_INTERN_CLASS = rb_intern("class");
-  RB_INTERN_NAME = rb_intern("name");
+  RB_INTERN_BIG_DECIMAL = rb_intern("BigDecimal");
+  RB_INTERN_TO_TIME = rb_intern("to_time");
+  RB_INTERN_MJD = rb_intern("mjd");
+  RB_INTERN_READ = rb_intern("read");
+  RB_INTERN_EACH = rb_intern("each");
+  decimalModes[DECIMAL_AS_FLOAT] = ID2SYM(rb_intern("float"));
+  decimalModes[DECIMAL_AS_BIG_DECIMAL] = ID2SYM(rb_intern("big_decimal"));
+  decimalModes[DECIMAL_AS_RATIONAL] = ID2SYM(rb_intern("rational"));
+  decimalModes[DECIMAL_AS_INTEGER] = ID2SYM(rb_intern("integer"));
   
   cDate = getClass("Date");
   cDateTime = getClass("DateTime");
+  rb_global_variable(&localOffset);
 }
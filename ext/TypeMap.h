@@ -35,9 +35,20 @@
       #define RUBY_H_INCLUDED
    #endif
 
+/* Type definitions. */
+typedef void (*ParameterBinder)(VALUE, XSQLVAR *, VALUE, VALUE);
+
+typedef struct {
+  short           type,
+                  length;
+  ParameterBinder binder;
+} ParameterInfo;
+
 /* Function prototypes. */
 void Init_TypeMap(VALUE);
-VALUE toValue(XSQLVAR *, VALUE, VALUE);
-void setParameters(XSQLDA *, VALUE, VALUE, VALUE);
+VALUE toValue(XSQLVAR *, int, short, short, short, long, VALUE, VALUE);
+short getDecimalMode(void);
+ParameterInfo *describeParameters(XSQLDA *);
+void setParameters(XSQLDA *, ParameterInfo *, VALUE, VALUE, VALUE);
 
 #endif /* FIRERUBY_TYPE_MAP_H */
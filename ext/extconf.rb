@@ -37,5 +37,13 @@ end
 # Make sure the firebird stuff is included.
 dir_config("firebird", firebird_include, firebird_lib)
 
+# Check for the API used to release the global VM lock around blocking calls.
+have_header("ruby/thread.h")
+have_func("rb_thread_call_without_gvl", "ruby/thread.h")
+
+# Check for the API used to build strings in the database character sets.
+have_header("ruby/encoding.h")
+have_func("rb_enc_interned_str", "ruby/encoding.h")
+
 # Generate the Makefile.
 create_makefile("rubyfb_lib")
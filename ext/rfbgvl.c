@@ -0,0 +1,310 @@
+/*------------------------------------------------------------------------------
+ * rfbgvl.c
+ *----------------------------------------------------------------------------*/
+
+/* Includes. */
+#include "rfbgvl.h"
+#ifdef HAVE_RUBY_THREAD_H
+  #include "ruby/thread.h"
+#endif
+
+/* Type definitions. */
+typedef struct {
+  ISC_STATUS      *status;
+  isc_db_handle   *connection;
+  isc_tr_handle   *transaction;
+  isc_stmt_handle *statement;
+  isc_blob_handle *blob;
+  const char      *text;
+  char            *buffer;
+  short           length,
+                  size;
+  unsigned short  dialect,
+                  capacity,
+                  *quantity;
+  XSQLDA          *input,
+                  *output;
+  ISC_STATUS      result;
+} BlockingCall;
+
+typedef struct {
+  rfb_blocking_function function;
+  void                  *data,
+                        *result;
+  int                   called;
+} UnlockedCall;
+
+#if defined(FB_API_VER) && FB_API_VER >= 25
+/**
+ * This function is the unblock function used when Ruby needs to interrupt a
+ * thread waiting on the database server. It asks the server to cancel the
+ * operation running on the connection, which makes the blocking call return
+ * with an error.
+ *
+ * @param  connection  A pointer to the database handle of the connection.
+ *
+ */
+static void cancelOperation(void *connection) {
+  ISC_STATUS status[ISC_STATUS_LENGTH];
+
+  if(*(isc_db_handle *)connection != 0) {
+    fb_cancel_operation(status, (isc_db_handle *)connection, fb_cancel_raise);
+  }
+}
+#endif
+
+#ifdef HAVE_RB_THREAD_CALL_WITHOUT_GVL
+/**
+ * This function is run by rb_thread_call_without_gvl2 in place of the blocking
+ * function itself, so that rfb_without_gvl can tell whether it was run at all.
+ *
+ * @param  data  A pointer to the UnlockedCall structure for the call.
+ *
+ * @return  Always NULL.
+ *
+ */
+static void *runUnlocked(void *data) {
+  UnlockedCall *call = (UnlockedCall *)data;
+
+  call->called = 1;
+  call->result = call->function(call->data);
+  return(NULL);
+}
+#endif
+
+/**
+ * This function runs a function that blocks on the database server with the
+ * Ruby global VM lock released, so that other Ruby threads keep running while
+ * the server is waited on. The function must not touch any Ruby objects.
+ *
+ * The function is always run and this function never raises. An interrupt
+ * received while the function was running (or already pending beforehand) is
+ * left pending, so that the caller can first bring its own state up to date
+ * with the result of the call; the interrupt is then delivered at the next
+ * point where the interpreter checks for one, or earlier by an explicit call
+ * to rb_thread_check_ints.
+ *
+ * @param  function    The function to be run.
+ * @param  data        The data to be passed to the function.
+ * @param  connection  A pointer to the database handle the function works on,
+ *                     used to cancel the operation if the thread is
+ *                     interrupted. May be NULL, in which case the operation
+ *                     can not be interrupted.
+ *
+ * @return  The value returned by the function.
+ *
+ */
+void *rfb_without_gvl(rfb_blocking_function function, void *data,
+                      isc_db_handle *connection) {
+#ifdef HAVE_RB_THREAD_CALL_WITHOUT_GVL
+  rb_unblock_function_t *unblock = NULL;
+  UnlockedCall          call;
+
+#if defined(FB_API_VER) && FB_API_VER >= 25
+  if(connection != NULL) {
+    unblock = cancelOperation;
+  }
+#endif
+  call.function = function;
+  call.data     = data;
+  call.result   = NULL;
+  call.called   = 0;
+  rb_thread_call_without_gvl2(runUnlocked, &call, unblock, connection);
+
+  /* The call is skipped when an interrupt was already pending, run it here. */
+  if(!call.called) {
+    call.result = function(data);
+  }
+  return(call.result);
+#else
+  return(function(data));
+#endif
+}
+
+static void *attachDatabase(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_attach_database(call->status, call->length, call->text,
+                                     call->connection, call->size,
+                                     call->buffer);
+  return(NULL);
+}
+
+static void *prepareStatement(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_dsql_prepare(call->status, call->transaction,
+                                  call->statement, 0, call->text,
+                                  call->dialect, call->output);
+  return(NULL);
+}
+
+static void *executeStatement(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_dsql_execute2(call->status, call->transaction,
+                                   call->statement, call->dialect,
+                                   call->input, call->output);
+  return(NULL);
+}
+
+static void *fetchRow(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_dsql_fetch(call->status, call->statement, call->dialect,
+                                call->output);
+  return(NULL);
+}
+
+static void *commitTransaction(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_commit_transaction(call->status, call->transaction);
+  return(NULL);
+}
+
+static void *rollbackTransaction(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_rollback_transaction(call->status, call->transaction);
+  return(NULL);
+}
+
+static void *getSegment(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_get_segment(call->status, call->blob, call->quantity,
+                                 call->capacity, call->buffer);
+  return(NULL);
+}
+
+static void *putSegment(void *data) {
+  BlockingCall *call = (BlockingCall *)data;
+
+  call->result = isc_put_segment(call->status, call->blob, call->capacity,
+                                 call->text);
+  return(NULL);
+}
+
+/**
+ * The following functions are equivalents of the Firebird client functions
+ * of the same name that release the Ruby global VM lock while they wait on the
+ * database server. Where present, the trailing connection parameter is the
+ * database handle that is used to cancel the operation when the calling
+ * thread is interrupted.
+ *
+ */
+ISC_STATUS rfb_attach_database(ISC_STATUS *status, short length,
+                               const char *file, isc_db_handle *connection,
+                               short size, const char *dpb) {
+  BlockingCall call;
+
+  call.status     = status;
+  call.length     = length;
+  call.text       = file;
+  call.connection = connection;
+  call.size       = size;
+  call.buffer     = (char *)dpb;
+  rfb_without_gvl(attachDatabase, &call, NULL);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_dsql_prepare(ISC_STATUS *status, isc_tr_handle *transaction,
+                            isc_stmt_handle *statement, const char *sql,
+                            unsigned short dialect, XSQLDA *output,
+                            isc_db_handle *connection) {
+  BlockingCall call;
+
+  call.status      = status;
+  call.transaction = transaction;
+  call.statement   = statement;
+  call.text        = sql;
+  call.dialect     = dialect;
+  call.output      = output;
+  rfb_without_gvl(prepareStatement, &call, connection);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_dsql_execute2(ISC_STATUS *status, isc_tr_handle *transaction,
+                             isc_stmt_handle *statement, unsigned short dialect,
+                             XSQLDA *input, XSQLDA *output,
+                             isc_db_handle *connection) {
+  BlockingCall call;
+
+  call.status      = status;
+  call.transaction = transaction;
+  call.statement   = statement;
+  call.dialect     = dialect;
+  call.input       = input;
+  call.output      = output;
+  rfb_without_gvl(executeStatement, &call, connection);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_dsql_fetch(ISC_STATUS *status, isc_stmt_handle *statement,
+                          unsigned short dialect, XSQLDA *output,
+                          isc_db_handle *connection) {
+  BlockingCall call;
+
+  call.status    = status;
+  call.statement = statement;
+  call.dialect   = dialect;
+  call.output    = output;
+  rfb_without_gvl(fetchRow, &call, connection);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_commit_transaction(ISC_STATUS *status,
+                                  isc_tr_handle *transaction) {
+  BlockingCall call;
+
+  call.status      = status;
+  call.transaction = transaction;
+  rfb_without_gvl(commitTransaction, &call, NULL);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_rollback_transaction(ISC_STATUS *status,
+                                    isc_tr_handle *transaction) {
+  BlockingCall call;
+
+  call.status      = status;
+  call.transaction = transaction;
+  rfb_without_gvl(rollbackTransaction, &call, NULL);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_get_segment(ISC_STATUS *status, isc_blob_handle *blob,
+                           unsigned short *quantity, unsigned short capacity,
+                           char *buffer, isc_db_handle *connection) {
+  BlockingCall call;
+
+  call.status   = status;
+  call.blob     = blob;
+  call.quantity = quantity;
+  call.capacity = capacity;
+  call.buffer   = buffer;
+  rfb_without_gvl(getSegment, &call, connection);
+
+  return(call.result);
+}
+
+ISC_STATUS rfb_put_segment(ISC_STATUS *status, isc_blob_handle *blob,
+                           unsigned short size, const char *buffer,
+                           isc_db_handle *connection) {
+  BlockingCall call;
+
+  call.status   = status;
+  call.blob     = blob;
+  call.capacity = size;
+  call.text     = buffer;
+  rfb_without_gvl(putSegment, &call, connection);
+
+  return(call.result);
+}
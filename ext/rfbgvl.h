@@ -0,0 +1,35 @@
+#ifndef RFB_GVL_H
+#define RFB_GVL_H
+
+#ifndef IBASE_H_INCLUDED
+  #include "ibase.h"
+  #define IBASE_H_INCLUDED
+#endif
+
+#ifndef RUBY_H_INCLUDED
+  #include "ruby.h"
+  #define RUBY_H_INCLUDED
+#endif
+
+typedef void *(*rfb_blocking_function)(void *);
+
+void *rfb_without_gvl(rfb_blocking_function, void *, isc_db_handle *);
+
+ISC_STATUS rfb_attach_database(ISC_STATUS *, short, const char *,
+                               isc_db_handle *, short, const char *);
+ISC_STATUS rfb_dsql_prepare(ISC_STATUS *, isc_tr_handle *, isc_stmt_handle *,
+                            const char *, unsigned short, XSQLDA *,
+                            isc_db_handle *);
+ISC_STATUS rfb_dsql_execute2(ISC_STATUS *, isc_tr_handle *, isc_stmt_handle *,
+                             unsigned short, XSQLDA *, XSQLDA *,
+                             isc_db_handle *);
+ISC_STATUS rfb_dsql_fetch(ISC_STATUS *, isc_stmt_handle *, unsigned short,
+                          XSQLDA *, isc_db_handle *);
+ISC_STATUS rfb_commit_transaction(ISC_STATUS *, isc_tr_handle *);
+ISC_STATUS rfb_rollback_transaction(ISC_STATUS *, isc_tr_handle *);
+ISC_STATUS rfb_get_segment(ISC_STATUS *, isc_blob_handle *, unsigned short *,
+                           unsigned short, char *, isc_db_handle *);
+ISC_STATUS rfb_put_segment(ISC_STATUS *, isc_blob_handle *, unsigned short,
+                           const char *, isc_db_handle *);
+
+#endif /* RFB_GVL_H */
@@ -4,25 +4,158 @@
 
 /* Includes. */
 #include "rfbstr.h"
+#ifdef HAVE_RUBY_ENCODING_H
+  #include "ruby/encoding.h"
+#endif
+
+#ifndef HAVE_RB_ENC_INTERNED_STR
+/* Strings interned by rfbinternstr, a Hash of encoding index to a Hash of the
+   interned strings in the encoding. */
+static VALUE internedStrings = Qnil;
+
+/* The maximum number of strings interned per encoding before they are
+   dropped. */
+#define INTERNED_STRINGS_LIMIT 4096
+#endif
+
+/**
+ * This function finds the index of a Ruby encoding from its name
+ *
+ * @param name  The name of the encoding, may be nil
+ *
+ * @return  The encoding index, the index of ASCII-8BIT if the encoding is
+ *          unknown
+ *
+ */
+int rfbencoding(VALUE name) {
+#ifdef HAVE_RUBY_ENCODING_H
+  int index = -1;
+
+  if (name != Qnil) {
+    index = rb_enc_find_index(StringValueCStr(name));
+  }
+  return (index < 0 ? rb_ascii8bit_encindex() : index);
+#else
+  return 0;
+#endif
+}
 
 /**
  * This function converts a sql data into ruby string
  * respecting data encoding
  *
- * @param connection  The connection object relating to the data
- * @param sqlsubtype  SQL subtype of the field (fot character types - used to hold encoding information)
+ * @param encoding  The index of the Ruby encoding for the data
  * @param data  A pointer to the sql data
  * @param length  Length of the sql data
  *
  * @return  A Ruby String object with correct encoding
  *
  */
-VALUE rfbstr(VALUE connection, short sqlsubtype, const char *data, short length) {
+VALUE rfbstr(int encoding, const char *data, long length) {
   VALUE value = Qnil;
   if (length >= 0) {
+#ifdef HAVE_RUBY_ENCODING_H
+    value = rb_enc_str_new(data, length, rb_enc_from_index(encoding));
+#else
     value = rb_str_new(data, length);
-    value = rb_funcall(connection, rb_intern("force_encoding"), 2, value, INT2FIX(sqlsubtype));
+#endif
   }
   return value;
 }
 
+/**
+ * This function converts a sql data into a frozen, interned ruby string
+ * respecting data encoding, so that repeated values share one String
+ *
+ * @param encoding  The index of the Ruby encoding for the data
+ * @param data  A pointer to the sql data
+ * @param length  Length of the sql data
+ *
+ * @return  A frozen Ruby String object with correct encoding
+ *
+ */
+VALUE rfbinternstr(int encoding, const char *data, long length) {
+#ifdef HAVE_RB_ENC_INTERNED_STR
+  if (length < 0) {
+    return Qnil;
+  }
+  return rb_enc_interned_str(data, length, rb_enc_from_index(encoding));
+#else
+  VALUE value = rfbstr(encoding, data, length),
+        strings,
+        interned;
+
+  if (value == Qnil) {
+    return value;
+  }
+  if (internedStrings == Qnil) {
+    internedStrings = rb_hash_new();
+    rb_global_variable(&internedStrings);
+  }
+  strings = rb_hash_lookup(internedStrings, INT2FIX(encoding));
+  if (strings == Qnil) {
+    strings = rb_hash_new();
+    rb_hash_aset(internedStrings, INT2FIX(encoding), strings);
+  }
+  interned = rb_hash_lookup(strings, value);
+  if (interned == Qnil) {
+    if (RHASH_SIZE(strings) >= INTERNED_STRINGS_LIMIT) {
+      rb_hash_clear(strings);
+    }
+    interned = rb_obj_freeze(value);
+    rb_hash_aset(strings, interned, interned);
+  }
+  return interned;
+#endif
+}
+
+/**
+ * This function finds the length of CHAR data once the trailing blanks used
+ * to pad it to its declared width are removed. Only blanks that start a
+ * character are removed, so multi-byte characters are never cut, and data in
+ * binary or non-ASCII compatible encodings is left untouched.
+ *
+ * @param encoding  The index of the Ruby encoding for the data
+ * @param data  A pointer to the sql data
+ * @param length  Length of the sql data
+ *
+ * @return  The length of the data without its padding
+ *
+ */
+long rfbtrimlen(int encoding, const char *data, long length) {
+#ifdef HAVE_RUBY_ENCODING_H
+  rb_encoding *enc = rb_enc_from_index(encoding);
+  const char  *end = data + length;
+
+  if (encoding == rb_ascii8bit_encindex() || !rb_enc_asciicompat(enc)) {
+    return length;
+  }
+  while (length > 0 && data[length - 1] == ' ' &&
+         rb_enc_left_char_head(data, &data[length - 1], end, enc) ==
+         &data[length - 1]) {
+    length--;
+  }
+#else
+  while (length > 0 && data[length - 1] == ' ') {
+    length--;
+  }
+#endif
+  return length;
+}
+
+/**
+ * This function sets the encoding of a ruby string that has been filled with
+ * sql data in place
+ *
+ * @param value  The String to set the encoding of
+ * @param encoding  The index of the Ruby encoding for the data
+ *
+ * @return  The String
+ *
+ */
+VALUE rfbsetencoding(VALUE value, int encoding) {
+#ifdef HAVE_RUBY_ENCODING_H
+  rb_enc_associate_index(value, encoding);
+#endif
+  return value;
+}
@@ -7,6 +7,10 @@
 #endif
 #include "rfbint.h"
 
-VALUE rfbstr(VALUE, short, const char *, short);
+int rfbencoding(VALUE);
+VALUE rfbstr(int, const char *, long);
+VALUE rfbinternstr(int, const char *, long);
+long rfbtrimlen(int, const char *, long);
+VALUE rfbsetencoding(VALUE, int);
 
 #endif /* RFB_STR_H */
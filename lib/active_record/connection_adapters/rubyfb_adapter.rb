@@ -578,19 +578,27 @@ module ActiveRecord
 
       # Inserts the given fixture into the table. Overridden to properly handle blobs.
       def insert_fixture(fixture, table_name) #:nodoc:
-        if ActiveRecord::Base.pluralize_table_names
-          klass = table_name.singularize.camelize
-        else
-          klass = table_name.camelize
-        end
-        klass = klass.constantize rescue nil
-        if klass.respond_to?(:ancestors) && klass.ancestors.include?(ActiveRecord::Base)
-          with_blobs_disabled do
-            super
+        insert_fixtures([fixture], table_name)
+      end
+
+      # Inserts the given fixtures into the table, packing the fixtures that
+      # set the same columns into EXECUTE BLOCK statements, while a single
+      # fixture is written with a plain INSERT. Values are bound as
+      # parameters, so BLOB columns are written directly.
+      def insert_fixtures(fixtures, table_name) #:nodoc:
+        columns = Hash[self.columns(table_name).collect { |c| [c.name, c] }]
+        fixtures.collect { |fixture| fixture.to_a }.group_by { |pairs| pairs.collect(&:first) }.each do |names, rows|
+          values = rows.collect do |pairs|
+            pairs.collect do |name, value|
+              value = value.read if value.respond_to?(:read)
+              type_cast(value, columns[name.to_s])
+            end
+          end
+          table = quote_table_name(table_name)
+          keys = names.collect { |name| quote_column_name(name) }
+          log("INSERT INTO #{table} (#{keys.join(', ')}) VALUES (...)", 'Fixture Insert') do
+            @connection.bulk_insert(table, keys, values, @transaction)
           end
-          write_blobs(table_name, klass, fixture, false)
-        else
-          super
         end
       end
   
@@ -922,8 +930,8 @@ module ActiveRecord
           exec_result = exec_query(sql, name, binds)
           if exec_result.instance_of?(Rubyfb::ResultSet)
             fields = exec_result.statement.metadata.collect{ |m| fb_to_ar_case(m.key) }
-            exec_result.each do |row|
-              rows << row.values.collect do |value|
+            exec_result.each_array do |values|
+              rows << values.collect! do |value|
                 case value
                   when Rubyfb::Blob
                     value.to_s.tap do
@@ -3,8 +3,7 @@ require 'rubyfb/rubyfb_options'
 require 'rubyfb_lib'
 require 'rubyfb/sql_type'
 require 'rubyfb/procedure_call'
-require 'rubyfb/row'
-require 'rubyfb/result_set'
 require 'rubyfb/statement'
+require 'rubyfb/bulk_writer'
 require 'rubyfb/connection'
 
@@ -0,0 +1,107 @@
+module Rubyfb
+  # Executes a DML statement for many rows at a time by packing the rows
+  # into EXECUTE BLOCK statements, one round trip per block
+  class BulkWriter
+    MESSAGE_LIMIT = 65535
+    STATEMENT_LIMIT = 65535
+    MAX_ROWS = 255
+
+    attr_reader :connection, :sql, :types
+
+    # sql is a DML statement with a ? marker for each value of a row, types
+    # holds the SQL type of each marker e.g. 'INTEGER' or 'TYPE OF COLUMN T.C'
+    def initialize(connection, sql, types)
+      @connection = connection
+      @sql = sql.sub(/;\s*\z/, '')
+      @types = types
+      @parts = split_markers(@sql)
+      @statements = {}
+      @rows_per_block = nil
+      unless @parts.size == types.size + 1
+        raise ArgumentError, "Expected #{@parts.size - 1} parameter types, got #{types.size}"
+      end
+    end
+
+    def self.insert(connection, table, columns)
+      markers = (['?'] * columns.size).join(', ')
+      new(connection,
+          "INSERT INTO #{table} (#{columns.join(', ')}) VALUES (#{markers})",
+          columns.collect {|column| "TYPE OF COLUMN #{table}.#{column}"})
+    end
+
+    # writes an Array of parameter Arrays, returns the number of rows written
+    def execute(rows, transaction=nil)
+      if transaction.nil?
+        written = 0
+        connection.start_transaction {|tr| written = execute(rows, tr)}
+        return written
+      end
+
+      size = rows_per_block
+      offset = 0
+      while offset < rows.size
+        block = rows[offset, size]
+        statement(block.size).exec(block.flatten(1), transaction)
+        offset += block.size
+      end
+      rows.size
+    end
+
+    def rows_per_block
+      @rows_per_block ||= begin
+        message = [statement(1).input_length, 1].max
+        row_text = block_sql(2).size - block_sql(1).size
+        rows = [MESSAGE_LIMIT / message,
+                (STATEMENT_LIMIT - block_sql(1).size + row_text) / row_text,
+                MAX_ROWS].min
+        [rows, 1].max
+      end
+    end
+
+    def close
+      @statements.each_value {|statement| statement.close}
+      @statements.clear
+    end
+  private
+    # keeps the statement for full blocks plus the latest partial block
+    def statement(count)
+      @statements[count] ||= begin
+        @statements.keys.each do |size|
+          @statements.delete(size).close unless size == 1 || size == @rows_per_block
+        end
+        connection.create_statement(block_sql(count))
+      end
+    end
+
+    def block_sql(count)
+      declarations = []
+      body = []
+      count.times do |row|
+        names = (0...types.size).collect {|index| format('P%03d_%d', row, index)}
+        names.each_with_index do |name, index|
+          declarations << "#{name} #{types[index]} = ?"
+        end
+        body << @parts.zip(names.collect {|name| ":#{name}"}).flatten.join + ';'
+      end
+      "EXECUTE BLOCK (#{declarations.join(', ')}) AS BEGIN #{body.join(' ')} END"
+    end
+
+    # splits sql at the ? markers that are not within quotes
+    def split_markers(sql)
+      parts = [String.new]
+      quote = nil
+      sql.each_char do |char|
+        if quote
+          quote = nil if char == quote
+          parts.last << char
+        elsif char == '?'
+          parts << String.new
+        else
+          quote = char if char == "'" || char == '"'
+          parts.last << char
+        end
+      end
+      parts
+    end
+  end
+end
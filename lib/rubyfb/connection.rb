@@ -4,10 +4,24 @@ module Rubyfb
     def prepare_call(procedure_name)
       Rubyfb::ProcedureCall.new(self, procedure_name)
     end
-    
-    def force_encoding(fb_str, sqlsubtype)
-      fb_str
+
+    # Inserts rows into a table packing many rows into each EXECUTE BLOCK,
+    # a single row is written with a plain INSERT
+    # returns the number of rows inserted
+    def bulk_insert(table, columns, rows, transaction=nil)
+      return 0 if rows.empty?
+      if rows.size == 1
+        markers = (['?'] * columns.size).join(', ')
+        execute_for("INSERT INTO #{table} (#{columns.join(', ')}) VALUES (#{markers})",
+                    rows.first, transaction)
+        return 1
+      end
+      # writers are closed with the statement cache, on close or DDL
+      key = "#{table} (#{columns.join(', ')})"
+      writer = (@bulk_writers[key] ||= Rubyfb::BulkWriter.insert(self, table, columns))
+      writer.execute(rows, transaction)
     end
+    
   private
     def init_m17n
       return unless String.method_defined?(:force_encoding)
@@ -18,13 +32,6 @@ module Rubyfb
           @charset_map[row['RDB$CHARACTER_SET_ID']]=Rubyfb::Options.charset_name_map[row['RDB$CHARACTER_SET_NAME'].strip]
         end
       end
-      instance_eval do 
-        def force_encoding(fb_str, sqlsubtype)
-          fb_str.tap do |s|
-            s.force_encoding(@charset_map[sqlsubtype])
-          end
-        end
-      end
     end
   end
 end
@@ -9,13 +9,5 @@ module Rubyfb
     def create_column_metadata
       ColumnMetadata.new
     end
-    
-    def create_result_set(transaction)
-      ResultSet.new(self, transaction)
-    end
-    
-    def is_active_result_set(object)
-      object.kind_of?(ResultSet) && object.active?
-    end
   end
 end
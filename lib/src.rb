@@ -373,6 +373,38 @@ module Rubyfb
       #
       def create_statement(sql)
       end
+
+
+      #
+      # This method fetches the maximum number of prepared statements that the
+      # connection keeps for reuse by the execute, execute_for and
+      # execute_immediate methods. The cache is disabled, the default, when
+      # this is zero.
+      #
+      def statement_cache_size
+      end
+
+
+      #
+      # This method sets the maximum number of prepared statements that the
+      # connection keeps for reuse, keyed by their SQL text. The least
+      # recently used statements are closed when the cache is full. The cache
+      # is emptied whenever a DDL statement is executed or the connection is
+      # closed.
+      #
+      # ==== Parameters
+      # size::  The number of statements to cache, zero to disable the cache.
+      #
+      def statement_cache_size=(size)
+      end
+
+
+      #
+      # This method returns a Hash of statistics for the statement cache with
+      # the keys :size, :capacity, :hits, :misses and :evictions.
+      #
+      def statement_cache_stats
+      end
    end
    
    
@@ -527,6 +559,13 @@ module Rubyfb
    # This class  represents a prepared SQL statement that may be executed more
    # than once.
    #
+   # Other Ruby threads keep running while a statement waits on the database
+   # server. Statement objects are not thread safe however, so a statement
+   # (and any ResultSet it returned) must only be used by one thread at a
+   # time. An interrupted thread (Thread#raise, Thread#kill, Timeout) has its
+   # database call cancelled and the interrupt delivered once the statement
+   # state has been brought up to date.
+   #
    class Statement
       # A definition for a SQL statement type constant.
       SELECT_STATEMENT            = 1
@@ -618,6 +657,14 @@ module Rubyfb
       #
       def parameter_count
       end
+
+      #
+      # This method fetches an upper bound, in bytes, of the size of the
+      # message that carries the dynamic parameters of a statement object to
+      # the server. Firebird limits this message to 64K.
+      #
+      def input_length
+      end
       
       
       #
@@ -657,7 +704,10 @@ module Rubyfb
       #               will be made to convert the values passed in to the
       #               appropriate types but no guarantees are made (especially
       #               in the case of text fields, which will simply use to_s
-      #               if the object passed is not a String).
+      #               if the object passed is not a String). Blob values may
+      #               be given as a String, as an object responding to read
+      #               (such as a File) or as an Enumerator that yields String
+      #               chunks, and are streamed to the database in segments.
       #
       # transaction:: A reference to the transaction object (optional). 
       #               If this parameter is nil - the statement is execute within 
@@ -701,6 +751,37 @@ module Rubyfb
          yield row
       end
 
+      #
+      # This method executes a non-query statement once for each of a list of
+      # parameter sets. The sets are bound and executed in a single loop,
+      # reusing the statement input buffers, which is much cheaper than
+      # calling exec() for each set. The method returns a Hash holding the
+      # number of sets executed (:executed), the total number of rows
+      # affected (:affected, nil if not counted) and an Array of the errors
+      # raised, each as a two element Array of the set index and exception
+      # (:errors).
+      #
+      # ==== Parameters
+      # rows::         An array of parameter arrays for the statement.
+      #
+      # transaction::  A reference to the transaction object (optional). If
+      #                this parameter is nil the batch is executed within its
+      #                own (implicit) transaction, which is committed when
+      #                the batch is complete.
+      #
+      # options::      A Hash of options (optional). Set :affected to false to
+      #                skip counting the rows affected by each set, and set
+      #                :continue to true to record errors and carry on with
+      #                the following sets rather than stopping at the first.
+      #
+      # ==== Exception
+      # Exception::  Generated whenever a problem occurs translating one of the
+      #              input parameters or executing the SQL statement and
+      #              :continue is not set, or if the statement is a query.
+      #
+      def exec_batch(rows, transaction=nil, options=nil)
+      end
+
       #
       # This method releases the database resources associated with a Statement
       # object and should be explicitly called when a Statement object is of
@@ -721,6 +802,137 @@ module Rubyfb
       #
       def plan
       end
+
+      #
+      # This method fetches up to count rows from an executed query statement
+      # in a single call, returning them as an Array of row value Arrays. Less
+      # than count rows are returned only when the cursor has been exhausted.
+      # Statements that are not cursor statements (e.g. procedure calls)
+      # return their single output row.
+      #
+      # ==== Parameters
+      # count::        The maximum number of rows to be fetched.
+      # transaction::  The transaction that the statement was executed in.
+      #
+      # ==== Exceptions
+      # FireRubyError::  Generated whenever a problem occurs fetching the rows.
+      #
+      def fetch_batch(count, transaction)
+      end
+
+      #
+      # This method fetches up to count rows from an executed query statement
+      # and returns them column by column, as an Array holding an Array of
+      # values for each column.
+      #
+      # When packed is true, INTEGER, BIGINT, DOUBLE PRECISION and DATE
+      # columns are instead returned as a two element Array. The first entry
+      # is a binary String of native values (use unpack with 'l*', 'q*', 'd*'
+      # and 'l*' respectively) and the second is a bitmap String with a bit
+      # set for each null value (use unpack with 'b*'). Null values are zero
+      # in the packed data. Scaled INTEGER and BIGINT columns hold their
+      # unscaled values, and DATE values are day numbers counted from
+      # November 17th, 1858.
+      #
+      # ==== Parameters
+      # count::        The maximum number of rows to be fetched.
+      # transaction::  The transaction that the statement was executed in.
+      # packed::       True to return fixed width numeric columns packed.
+      #                Defaults to false.
+      #
+      # ==== Exceptions
+      # FireRubyError::  Generated whenever a problem occurs fetching the rows.
+      #
+      def fetch_columns(count, transaction, packed=false)
+      end
+
+      #
+      # This method returns true if CHAR and VARCHAR values fetched through
+      # the statement are returned as frozen, interned Strings. The default
+      # comes from $FireRubySettings[:INTERN_STRINGS] when the statement is
+      # created.
+      #
+      def intern_strings?
+      end
+
+      #
+      # This method sets whether CHAR and VARCHAR values fetched through the
+      # statement are returned as frozen, interned Strings. Interning lets
+      # repeated values, such as status or currency codes, share one String
+      # instead of allocating a new one per row.
+      #
+      # ==== Parameters
+      # setting::  True to intern values, false to return new Strings.
+      #
+      def intern_strings=(setting)
+      end
+
+      #
+      # This method returns true if the blanks padding CHAR values fetched
+      # through the statement are removed. The default comes from
+      # $FireRubySettings[:TRIM_CHAR] when the statement is created.
+      #
+      def trim_char?
+      end
+
+      #
+      # This method sets whether the blanks padding CHAR values fetched through
+      # the statement to their declared width are removed before the values
+      # are returned, saving a call to rstrip on each value. Multi-byte
+      # characters are never cut.
+      #
+      # ==== Parameters
+      # setting::  True to remove the padding, false to keep it.
+      #
+      def trim_char=(setting)
+      end
+
+      #
+      # This method returns true if the rows of the result sets generated by
+      # the statement decode their column values on first access. The default
+      # comes from $FireRubySettings[:LAZY_ROWS] when the statement is
+      # created.
+      #
+      def lazy_rows?
+      end
+
+      #
+      # This method sets whether the rows of the result sets generated by the
+      # statement decode their column values on first access. A lazy row
+      # keeps a compact copy of the raw row data and converts a column, or
+      # opens a blob, only when the column is read, which saves work when
+      # only a few columns of a wide row are used. Columns that are read
+      # after the transaction for the row has ended can not open blobs.
+      #
+      # ==== Parameters
+      # setting::  True for lazy rows, false to decode rows as they are
+      #            fetched.
+      #
+      def lazy_rows=(setting)
+      end
+
+      #
+      # This method returns the size in bytes up to which blobs fetched
+      # through the statement are returned as Strings, 0 if blobs are always
+      # returned as Blob objects. The default comes from
+      # $FireRubySettings[:INLINE_BLOBS] when the statement is created.
+      #
+      def inline_blobs
+      end
+
+      #
+      # This method sets the size in bytes up to which blobs fetched through
+      # the statement are read as they are fetched and returned as Strings in
+      # the blob character set. The blob is closed straight away, saving the
+      # calls to Blob#to_s and Blob#close for small text blobs. Larger blobs
+      # are returned as Blob objects as before.
+      #
+      # ==== Parameters
+      # setting::  The size limit in bytes, nil or 0 to always return Blob
+      #            objects.
+      #
+      def inline_blobs=(setting)
+      end
    end
    
    
@@ -890,6 +1102,41 @@ module Rubyfb
       #
       def each(&block)
       end
+
+
+      #
+      # This method iterates the (remaining) rows of a ResultSet object,
+      # passing the values of each row to the block as an Array. No Row
+      # objects are created, making this the cheapest way to read a large
+      # result set.
+      #
+      # ==== Parameters
+      # block::  A block that takes a single parameter, an Array of the row
+      #          values.
+      #
+      def each_array(&block)
+      end
+
+
+      #
+      # This method iterates the (remaining) rows of a ResultSet object,
+      # passing the block a Hash of the column keys to the values of each row.
+      #
+      # ==== Parameters
+      # block::  A block that takes a single parameter, a Hash of the row
+      #          column keys to values.
+      #
+      def each_hash(&block)
+      end
+
+
+      #
+      # This method fetches all of the (remaining) rows of a ResultSet object
+      # as an Array of Row objects and closes the ResultSet.
+      #
+      def to_a
+      end
+      alias :all :to_a
       
       
       #
@@ -1175,14 +1422,20 @@ module Rubyfb
    class Blob
       #
       # This is the constructor for the Blob class. This shouldn't really be
-      # used outside of the FireRuby library.
+      # used outside of the FireRuby library. A blob fetched from the database
+      # is not opened until its data or size are first needed, so blobs that
+      # are never used cost no extra calls to the server. As the blob is
+      # opened in the transaction it was fetched in, it must be first used
+      # before that transaction ends.
       #
       def initialize
       end
       
       
       #
-      # This method loads the entire data set for a blob as a string.
+      # This method loads the entire data set for a blob as a string. An
+      # exception is raised if some of the data has already been read with
+      # read, readpartial or each.
       #
       def to_s
       end
@@ -1198,10 +1451,61 @@ module Rubyfb
       #
       # This method loads the segments of a blob one after another. The blob
       # segments are passed as BINARY strings to the block passed to the method.
+      # If a buffer string is given, each segment is read into it in place and
+      # the same string is passed to the block each time, so the block must
+      # copy any data it wants to keep.
       #
-      def each
+      # ==== Parameters
+      # size::   The maximum number of bytes to pass to the block at a time,
+      #          up to 65535. Defaults to the largest segment of the blob.
+      # buffer:: A String to be reused for each segment (optional).
+      #
+      def each(size=nil, buffer=nil)
          yield segment
       end
+      
+      
+      #
+      # This method reads blob data in the manner of IO#read. Without a length
+      # the remainder of the blob is returned in the blob character set.
+      # With a length up to that many bytes are returned as a BINARY string,
+      # or nil at the end of the blob. If a buffer string is given, the data is
+      # read into it in place and the buffer is returned.
+      #
+      # ==== Parameters
+      # length:: The maximum number of bytes to read (optional).
+      # buffer:: A String to read the data into (optional).
+      #
+      def read(length=nil, buffer=nil)
+      end
+      
+      
+      #
+      # This method reads up to length bytes of blob data in the manner of
+      # IO#readpartial, raising an EOFError at the end of the blob. Together
+      # with read, this allows a blob to be streamed with bounded memory use,
+      # e.g. IO.copy_stream(blob, file).
+      #
+      # ==== Parameters
+      # length:: The maximum number of bytes to read.
+      # buffer:: A String to read the data into (optional).
+      #
+      def readpartial(length, buffer=nil)
+      end
+      
+      
+      #
+      # This method returns true once all of the blob data has been read.
+      #
+      def eof?
+      end
+      
+      
+      #
+      # This method returns the total length of the blob data in bytes.
+      #
+      def size
+      end
    end
    
    
@@ -5,6 +5,7 @@ require './TestSetup'
 require 'test/unit'
 require 'rubygems'
 require 'rubyfb'
+require 'stringio'
 
 include Rubyfb
 
@@ -78,5 +79,128 @@ class BlobTest < Test::Unit::TestCase
          cxn.execute_immediate('DROP TABLE BLOB_TEST')
       end
    end
-   
+
+   def test03
+      chunk = 'x' * 40000
+      @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+         cxn.execute_immediate('create table blob_test (id integer, data blob sub_type 0)')
+         cxn.start_transaction do |tx|
+            s = cxn.create_statement('INSERT INTO BLOB_TEST VALUES(?, ?)')
+            s.exec([1, StringIO.new(chunk * 5)], tx)
+            s.exec([2, [chunk, chunk].each], tx)
+            assert_raise(FireRubyException) {s.exec([3, [chunk, chunk]], tx)}
+            s.close
+
+            r = cxn.execute('SELECT * FROM BLOB_TEST ORDER BY ID', tx)
+            assert_equal(chunk * 5, r.fetch[1].to_s)
+            assert_equal(chunk * 2, r.fetch[1].to_s)
+            r.close
+         end
+         cxn.execute_immediate('DROP TABLE BLOB_TEST')
+      end
+   end
+
+   def test04
+      data = (0...100000).collect {|i| (i % 251).chr}.join
+      @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+         cxn.execute_immediate('create table blob_test (id integer, data blob sub_type 0)')
+         cxn.start_transaction do |tx|
+            s = cxn.create_statement('INSERT INTO BLOB_TEST VALUES(?, ?)')
+            s.exec([1, data], tx)
+            s.close
+
+            r = cxn.execute('SELECT DATA FROM BLOB_TEST', tx)
+            blob = r.fetch[0]
+            buffer = String.new
+            assert_same(buffer, blob.read(10, buffer))
+            assert_equal(data[0, 10], buffer)
+            assert_equal(data[10, 20], blob.readpartial(20))
+            assert_raise(FireRubyException) {blob.to_s}
+            assert_equal(false, blob.eof?)
+
+            output = StringIO.new
+            IO.copy_stream(blob, output)
+            assert_equal(data[30..-1], output.string)
+            assert_equal(true, blob.eof?)
+            assert_nil(blob.read(10, buffer))
+            assert_raise(EOFError) {blob.readpartial(10)}
+            blob.close
+            r.close
+         end
+         cxn.execute_immediate('DROP TABLE BLOB_TEST')
+      end
+   end
+
+   def test05
+      data = 'y' * 200000
+      @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+         cxn.execute_immediate('create table blob_test (id integer, data blob sub_type 0)')
+         cxn.start_transaction do |tx|
+            s = cxn.create_statement('INSERT INTO BLOB_TEST VALUES(?, ?)')
+            s.exec([1, data], tx)
+            s.close
+
+            r = cxn.execute('SELECT DATA FROM BLOB_TEST', tx)
+            blob = r.fetch[0]
+            buffer = String.new
+            total = ''
+            blob.each(1000, buffer) do |segment|
+               assert_same(buffer, segment)
+               assert(segment.size <= 1000)
+               total << segment
+            end
+            assert_equal(data, total)
+            blob.close
+            r.close
+         end
+         cxn.execute_immediate('DROP TABLE BLOB_TEST')
+      end
+   end
+
+   def test06
+      @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+         cxn.execute_immediate('create table blob_test (id integer, data blob sub_type 1)')
+         cxn.start_transaction do |tx|
+            s = cxn.create_statement('INSERT INTO BLOB_TEST VALUES(?, ?)')
+            s.exec([1, 'small'], tx)
+            s.exec([2, 'z' * 5000], tx)
+            s.close
+
+            s = cxn.create_statement('SELECT DATA FROM BLOB_TEST ORDER BY ID')
+            assert_equal(0, s.inline_blobs)
+            s.inline_blobs = 1024
+            assert_equal(1024, s.inline_blobs)
+            r = s.exec([], tx)
+            assert_equal('small', r.fetch[0])
+            blob = r.fetch[0]
+            assert_instance_of(Rubyfb::Blob, blob)
+            assert_equal('z' * 5000, blob.to_s)
+            blob.close
+            r.close
+            s.close
+         end
+         cxn.execute_immediate('DROP TABLE BLOB_TEST')
+      end
+   end
+
+   def test07
+      @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+         cxn.execute_immediate('create table blob_test (id integer, data blob sub_type 0)')
+         cxn.start_transaction do |tx|
+            s = cxn.create_statement('INSERT INTO BLOB_TEST VALUES(?, ?)')
+            (1..3).each {|id| s.exec([id, 'b' * (id * 1000)], tx)}
+            s.close
+
+            r = cxn.execute('SELECT ID, DATA FROM BLOB_TEST ORDER BY ID', tx)
+            blobs = []
+            r.each {|row| blobs << row[1]}
+            assert_equal(3000, blobs[2].size)
+            assert_equal('b' * 2000, blobs[1].to_s)
+            assert_equal(2000, blobs[1].size)
+            blobs.each {|blob| blob.close}
+            assert_raise(FireRubyException) {blobs[0].read}
+         end
+         cxn.execute_immediate('DROP TABLE BLOB_TEST')
+      end
+   end
 end
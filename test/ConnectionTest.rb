@@ -107,4 +107,107 @@ class ConnectionTest < Test::Unit::TestCase
       assert(tx1.active? == false)
       assert(tx3.active? == false)
    end
+
+   def test05
+      connection = @database.connect(DB_USER_NAME, DB_PASSWORD)
+      @connections.push(connection)
+      assert_equal(0, connection.statement_cache_size)
+
+      connection.statement_cache_size = 1
+      3.times do
+         connection.execute_immediate("SELECT 1 FROM RDB$DATABASE") {|row| }
+      end
+      stats = connection.statement_cache_stats
+      assert_equal(1, stats[:size])
+      assert_equal(1, stats[:misses])
+      assert_equal(2, stats[:hits])
+
+      connection.execute_immediate("SELECT 2 FROM RDB$DATABASE") {|row| }
+      assert_equal(1, connection.statement_cache_stats[:evictions])
+
+      connection.execute_immediate("CREATE TABLE CACHE_TEST (ID INTEGER)")
+      assert_equal(0, connection.statement_cache_stats[:size])
+   end
+
+   def test06
+      connection = @database.connect(DB_USER_NAME, DB_PASSWORD)
+      @connections.push(connection)
+      connection.execute_immediate("CREATE TABLE BULK_TEST (ID INTEGER, NAME VARCHAR(20))")
+
+      rows = (1..1000).collect {|id| [id, "Row #{id}"]}
+      assert_equal(1000, connection.bulk_insert("BULK_TEST", ["ID", "NAME"], rows))
+      connection.execute_immediate("SELECT COUNT(*), SUM(ID) FROM BULK_TEST") do |row|
+         assert_equal(1000, row[0])
+         assert_equal(500500, row[1])
+      end
+
+      writer = Rubyfb::BulkWriter.new(connection,
+                                      "UPDATE BULK_TEST SET NAME = ? WHERE ID = ?",
+                                      ["VARCHAR(20)", "INTEGER"])
+      assert(writer.rows_per_block > 1)
+      writer.execute([["First", 1], ["Last", 1000]])
+      writer.close
+      names = []
+      connection.execute_immediate("SELECT NAME FROM BULK_TEST WHERE ID IN (1, 1000) ORDER BY ID") do |row|
+         names << row[0]
+      end
+      assert_equal(["First", "Last"], names)
+
+      assert_equal(2, connection.bulk_insert("BULK_TEST", ["ID", "NAME"], [[1001, "A"], [1002, "B"]]))
+      assert_equal(1, connection.bulk_insert("BULK_TEST", ["ID", "NAME"], [[1003, "C"]]))
+      assert_equal(0, connection.bulk_insert("BULK_TEST", ["ID", "NAME"], []))
+      connection.execute_immediate("SELECT COUNT(*) FROM BULK_TEST WHERE ID > 1000") do |row|
+         assert_equal(3, row[0])
+      end
+   end
+
+   def test07
+      connection = @database.connect(DB_USER_NAME, DB_PASSWORD)
+      waiter     = @database.connect(DB_USER_NAME, DB_PASSWORD)
+      @connections.push(connection, waiter)
+      connection.execute_immediate("CREATE TABLE LOCK_TEST (ID INTEGER, VAL INTEGER)")
+      connection.execute_immediate("INSERT INTO LOCK_TEST VALUES (1, 0)")
+
+      # Hold an uncommitted update so that the waiting thread blocks on the
+      # record lock (the default transaction is a WAIT transaction).
+      holder = connection.start_transaction
+      holder.execute("UPDATE LOCK_TEST SET VAL = 1 WHERE ID = 1")
+      blocked = Thread.new do
+         waiter.start_transaction do |tx|
+            tx.execute("UPDATE LOCK_TEST SET VAL = 2 WHERE ID = 1")
+         end
+      end
+      Thread.pass until blocked.status == "sleep" || !blocked.alive?
+
+      # The main thread can only get here, and do database work, while the
+      # waiting thread is blocked if the GVL is released for the call.
+      count = nil
+      connection.execute_immediate("SELECT COUNT(*) FROM RDB$DATABASE") do |row|
+         count = row[0]
+      end
+      assert_equal(1, count)
+      assert(blocked.alive?, "waiting thread was not blocked on the lock")
+
+      holder.rollback
+      blocked.join
+      connection.execute_immediate("SELECT VAL FROM LOCK_TEST WHERE ID = 1") do |row|
+         assert_equal(2, row[0])
+      end
+      assert(connection.create_statement("SELECT 1 FROM RDB$DATABASE").sql.frozen?)
+   end
+
+   def test08
+      connection = @database.connect(DB_USER_NAME, DB_PASSWORD)
+      @connections.push(connection)
+      connection.statement_cache_size = 4
+
+      # A statement checked out when DDL clears the cache is not cached again.
+      connection.execute_immediate("SELECT 1 FROM RDB$DATABASE") do |row|
+         connection.execute_immediate("CREATE TABLE GENERATION_TEST (ID INTEGER)")
+      end
+      assert_equal(0, connection.statement_cache_stats[:size])
+
+      connection.execute_immediate("SELECT 1 FROM RDB$DATABASE") {|row| }
+      assert_equal(1, connection.statement_cache_stats[:size])
+   end
 end
@@ -45,4 +45,42 @@ class FieldCharacterSetTest < Test::Unit::TestCase
       end
     end
   end
+
+  def test02
+    db   = Database.new(DB_FILE, DB_CHAR_SET)
+    utf8_str = "Малко utf8 кирилица" * 2000
+    db.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate("CREATE TABLE BLOB_TABLE(SAMPLE_FIELD BLOB SUB_TYPE TEXT CHARACTER SET UTF8)")
+      cxn.start_transaction do |tr|
+        cxn.execute_for("INSERT INTO BLOB_TABLE VALUES (?)", [utf8_str], tr)
+        cxn.execute("SELECT * FROM BLOB_TABLE", tr) do |row|
+          text = row['SAMPLE_FIELD'].to_s
+          assert_equal(Encoding::UTF_8, text.encoding)
+          assert_equal(utf8_str, text)
+        end
+      end
+    end
+  end
+
+  def test03
+    db   = Database.new(DB_FILE, DB_CHAR_SET)
+    utf8_str = "Кирилица"
+    db.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate("CREATE TABLE CHAR_TABLE(SAMPLE_FIELD CHAR(12) CHARACTER SET UTF8)")
+      cxn.start_transaction do |tr|
+        cxn.execute_for("INSERT INTO CHAR_TABLE VALUES (?)", [utf8_str], tr)
+        s = cxn.create_statement("SELECT * FROM CHAR_TABLE")
+        r = s.exec(nil, tr)
+        assert_equal(utf8_str, s.fetch_batch(1, tr)[0][0].rstrip)
+        r.close
+        s.trim_char = true
+        r = s.exec(nil, tr)
+        text = s.fetch_batch(1, tr)[0][0]
+        assert_equal(Encoding::UTF_8, text.encoding)
+        assert_equal(utf8_str, text)
+        r.close
+        s.close
+      end
+    end
+  end
 end
@@ -185,4 +185,27 @@ class ResultSetTest < Test::Unit::TestCase
       assert_nil(results.fetch,
                  '#fetch after exhaustion was not nil')
    end
+
+   def test07
+      sql = 'SELECT TESTID, TESTINFO FROM TEST_TABLE ORDER BY TESTID'
+
+      arrays = []
+      @transactions.first.execute(sql).each_array {|values| arrays << values}
+      assert_equal([10, 'Record One.'], arrays.first)
+      assert_equal(5, arrays.size)
+
+      hashes = []
+      results = @transactions.first.execute(sql)
+      results.each_hash {|hash| hashes << hash}
+      assert_equal({'TESTID' => 50, 'TESTINFO' => 'Record Five.'}, hashes.last)
+      assert_equal(5, results.row_count)
+      assert(results.exhausted?)
+
+      results = @transactions.first.execute(sql)
+      results.fetch
+      rows = results.to_a
+      assert_equal([20, 30, 40, 50], rows.collect {|row| row[0]})
+      assert_equal(5, rows.last.number)
+      assert(results.exhausted?)
+   end
 end
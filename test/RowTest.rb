@@ -210,4 +210,39 @@ class RowTest < Test::Unit::TestCase
         puts "#{row}\n"
       end
    end
+
+   def test06
+      sql  = 'select COL01 one, COL02 two, COL03 one from rowtest'
+      rows = @connection.execute_immediate(sql)
+      row  = rows.fetch
+
+      assert_equal(1, row['ONE'])
+      assert_equal('Two', row['TWO'])
+      assert_equal(1, row[0])
+      assert_equal(3, row[-1])
+      assert_equal(3, row.column_count)
+      assert_equal(['ONE', 'TWO', 'ONE'], row.keys)
+      assert_raise(IndexError) { row['THREE'] }
+      assert_equal([1, 'Two', 3], row.dup.values)
+   ensure
+      rows.close if rows
+   end
+
+   def test07
+      s = @connection.create_statement('select * from all_types')
+      s.lazy_rows = true
+      rows = s.exec(nil, @transaction)
+      row  = rows.fetch
+
+      assert_equal(1, row.number)
+      assert_equal(12345, row['COL08'])
+      assert_nil(row['COL02'])
+      assert_equal('The End!', row[-1])
+      assert_equal(13, row.values.size)
+      assert_equal(100000, row.values[0])
+      assert_equal(row.to_hash['COL03'], row['COL03'])
+   ensure
+      rows.close if rows
+      s.close if s
+   end
 end
@@ -159,4 +159,130 @@ class StatementTest < Test::Unit::TestCase
       cxn.execute_immediate('DROP TABLE PLAN_TEST')
     end
   end
+
+  def test06
+    @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate('CREATE TABLE BATCH_TEST(ID INTEGER, TEXT VARCHAR(10))')
+      cxn.start_transaction do |tx|
+        s = cxn.create_statement('INSERT INTO BATCH_TEST VALUES(?, ?)')
+        5.times {|i| s.exec([i, "Row #{i}"], tx)}
+        s.close
+
+        s = cxn.create_statement('SELECT * FROM BATCH_TEST ORDER BY ID')
+        r = s.exec(nil, tx)
+        rows = s.fetch_batch(3, tx)
+        assert_equal([[0, 'Row 0'], [1, 'Row 1'], [2, 'Row 2']], rows)
+        rows = s.fetch_batch(3, tx)
+        assert_equal([[3, 'Row 3'], [4, 'Row 4']], rows)
+        r.close
+        s.close
+
+        r = cxn.execute('SELECT * FROM BATCH_TEST ORDER BY ID', tx)
+        assert_equal([0, 1, 2, 3, 4], r.collect {|row| row[0]})
+        assert_equal(5, r.row_count)
+        assert(r.exhausted?)
+
+        s = cxn.create_statement('SELECT ID, TEXT FROM BATCH_TEST ORDER BY ID')
+        r = s.exec(nil, tx)
+        assert_equal([[0, 1, 2], ['Row 0', 'Row 1', 'Row 2']],
+                     s.fetch_columns(3, tx))
+        r.close
+        r = s.exec(nil, tx)
+        ids, text = s.fetch_columns(10, tx, true)
+        assert_equal([0, 1, 2, 3, 4], ids[0].unpack('l*'))
+        assert_equal('00000', ids[1].unpack('b*')[0][0, 5])
+        assert_equal(5, text.size)
+        r.close
+        s.close
+
+        s = cxn.create_statement('INSERT INTO BATCH_TEST VALUES(?, ?)')
+        result = s.exec_batch([[5, 'Row 5'], [6, 'Row 6']], tx)
+        assert_equal({:executed => 2, :affected => 2, :errors => []}, result)
+        result = s.exec_batch([[7, 'Row 7'], [8, 'Far too long']], tx,
+                              :affected => false, :continue => true)
+        assert_equal(1, result[:executed])
+        assert_nil(result[:affected])
+        assert_equal(1, result[:errors][0][0])
+        assert_equal(8, cxn.execute('SELECT COUNT(*) FROM BATCH_TEST', tx).fetch[0])
+        assert_raise(TypeError) {s.exec_batch([[9, 'Row 9']], tx, true)}
+        s.close
+      end
+      cxn.execute_immediate('DROP TABLE BATCH_TEST')
+    end
+  end
+
+  def test07
+    @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate('CREATE TABLE REUSE_TEST(ID INTEGER, TEXT VARCHAR(10))')
+      cxn.start_transaction do |tx|
+        s = cxn.create_statement('INSERT INTO REUSE_TEST VALUES(?, ?)')
+        s.exec([1, 'A'], tx)
+        s.exec([2, nil], tx)
+        s.exec([nil, 'Longer'], tx)
+        s.exec([4, 'B'], tx)
+        s.close
+
+        r = cxn.execute('SELECT * FROM REUSE_TEST ORDER BY ID', tx)
+        assert_equal([[nil, 'Longer'], [1, 'A'], [2, nil], [4, 'B']],
+                     r.collect {|row| row.values})
+      end
+      cxn.execute_immediate('DROP TABLE REUSE_TEST')
+    end
+  end
+
+  def test08
+    @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      sql = 'SELECT RDB$RELATION_NAME FROM RDB$RELATIONS'
+      s1  = cxn.create_statement(sql).prepare
+      s2  = cxn.create_statement(sql).prepare
+
+      assert(s1.metadata.frozen?)
+      assert(s1.metadata.equal?(s2.metadata))
+      assert(s1.metadata[0].name.frozen?)
+      s1.close
+      s2.close
+    end
+  end
+
+  def test09
+    @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate('CREATE TABLE INTERN_TEST(ID INTEGER, CODE VARCHAR(3))')
+      cxn.start_transaction do |tx|
+        s = cxn.create_statement('INSERT INTO INTERN_TEST VALUES(?, ?)')
+        3.times {|i| s.exec([i, 'EUR'], tx)}
+        s.close
+
+        s = cxn.create_statement('SELECT ID, CODE FROM INTERN_TEST ORDER BY ID')
+        assert_equal(false, s.intern_strings?)
+        s.intern_strings = true
+        r = s.exec(nil, tx)
+        rows = s.fetch_batch(3, tx)
+        assert_equal(['EUR', 'EUR', 'EUR'], rows.collect {|row| row[1]})
+        assert(rows[0][1].frozen?)
+        assert(rows[0][1].equal?(rows[2][1]))
+        r.close
+        s.close
+      end
+      cxn.execute_immediate('DROP TABLE INTERN_TEST')
+    end
+  end
+
+  def test10
+    @database.connect(DB_USER_NAME, DB_PASSWORD) do |cxn|
+      cxn.execute_immediate('CREATE TABLE META_TEST(A INTEGER)')
+      sql = 'SELECT A FROM META_TEST'
+      s = cxn.create_statement(sql).prepare
+      assert_equal(:INTEGER, s.metadata[0].type)
+      s.close
+
+      # Not seen as DDL here, as for a change made by another process.
+      cxn.execute_immediate("EXECUTE BLOCK AS BEGIN EXECUTE STATEMENT "\
+                            "'ALTER TABLE META_TEST ALTER COLUMN A TYPE VARCHAR(20)'; END")
+      s = cxn.create_statement(sql).prepare
+      assert_equal(:VARCHAR, s.metadata[0].type)
+      assert_equal('META_TEST', s.metadata[0].relation)
+      s.close
+      cxn.execute_immediate('DROP TABLE META_TEST')
+    end
+  end
 end
@@ -5,6 +5,7 @@ require 'test/unit'
 require 'rubygems'
 require 'rubyfb'
 require 'date'
+require 'bigdecimal'
 
 include Rubyfb
 
@@ -89,4 +90,159 @@ class TypeTest < Test::Unit::TestCase
       end
       $FireRubySettings[:DATE_AS_DATE] = true
    end
+
+   def test03
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         cxn.start_transaction do |tx|
+            rows = tx.execute("select cast('2005-10-21 13:45:30.1234' as timestamp), "\
+                              "cast('13:45:30.5' as time) from rdb$database")
+            row  = rows.fetch
+            assert_equal(Time.local(2005, 10, 21, 13, 45, 30, 123400), row[0])
+            assert_equal(Time.local(1970, 1, 1, 13, 45, 30, 500000), row[1])
+            rows.close
+         end
+      ensure
+         cxn.close
+      end
+   end
+
+   def test04
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         sql = 'select COL03, COL04 from types_table order by COL01'
+         {:big_decimal => [BigDecimal('2378.65'), BigDecimal('192.345')],
+          :rational    => [Rational(237865, 100), Rational(192345, 1000)],
+          :integer     => [237865, 192345]}.each do |mode, expected|
+            $FireRubySettings[:DECIMAL_MODE] = mode
+            rows = cxn.execute_immediate(sql)
+            assert_equal(expected, rows.fetch.values)
+            rows.close
+         end
+
+         cxn.start_transaction do |tx|
+            stmt = cxn.create_statement("insert into types_table (COL01, COL03, COL04) "\
+                                        "values (?, ?, ?)")
+            stmt.exec([20, '12345678.91', BigDecimal('12.3456')], tx)
+            stmt.exec([30, 99999999, Rational(1, 8)], tx)
+            stmt.close
+         end
+         $FireRubySettings[:DECIMAL_MODE] = :big_decimal
+         rows = cxn.execute_immediate(sql)
+         rows.fetch
+         assert_equal([BigDecimal('12345678.91'), BigDecimal('12.346')], rows.fetch.values)
+         assert_equal([BigDecimal('99999999'), BigDecimal('0.125')], rows.fetch.values)
+         rows.close
+      ensure
+         $FireRubySettings[:DECIMAL_MODE] = :float
+         cxn.close
+      end
+   end
+
+   def test05
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         cxn.start_transaction do |tx|
+            stmt = cxn.create_statement("insert into types_table (COL01, COL02, COL09) "\
+                                        "values (?, ?, ?)")
+            stmt.exec([40, '12.5', 123], tx)
+            stmt.exec([50, 7, nil], tx)
+            stmt.exec([60, 2.25, 'Text'], tx)
+            stmt.close
+         end
+         rows = cxn.execute_immediate('select COL01, COL02, COL09 from types_table '\
+                                      'where COL01 >= 40 order by COL01')
+         assert_equal([[40, 12.5, '123'], [50, 7.0, nil], [60, 2.25, 'Text']],
+                      rows.collect {|row| row.values})
+      ensure
+         cxn.close
+      end
+   end
+
+   def test06
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         stamp = Time.local(2011, 3, 27, 10, 15, 20, 123400)
+         cxn.start_transaction do |tx|
+            stmt = cxn.create_statement("insert into types_table (COL01, COL05, COL06, COL08) "\
+                                        "values (?, ?, ?, ?)")
+            stmt.exec([70, stamp, stamp, stamp], tx)
+            stmt.exec([80, Date.new(1858, 11, 17),
+                       DateTime.new(1999, 12, 31, 23, 59, 59, stamp.to_datetime.offset),
+                       stamp.getutc], tx)
+            stmt.close
+         end
+         rows = cxn.execute_immediate('select COL05, COL06, COL08 from types_table '\
+                                      'where COL01 >= 70 order by COL01')
+         assert_equal([Date.new(2011, 3, 27), stamp,
+                       Time.local(1970, 1, 1, 10, 15, 20, 123400)], rows.fetch.values)
+         row = rows.fetch
+         assert_equal(Date.new(1858, 11, 17), row[0])
+         assert_equal(Time.local(1999, 12, 31, 23, 59, 59), row[1])
+         utc = stamp.getutc
+         assert_equal(Time.local(1970, 1, 1, utc.hour, utc.min, utc.sec, 123400), row[2])
+         rows.close
+      ensure
+         cxn.close
+      end
+   end
+
+   def test07
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         cxn.start_transaction do |tx|
+            stmt = cxn.create_statement("insert into types_table (COL01, COL04, COL10) "\
+                                        "values (?, ?, ?)")
+            assert_raise(RangeError) {stmt.exec([90, 1, '30000000.00'], tx)}
+            assert_raise(RangeError) {stmt.exec([90, 1, 30000000], tx)}
+            assert_raise(RangeError) {stmt.exec([90, BigDecimal('3000000'), 1], tx)}
+            stmt.exec([90, 1, '21474836.47'], tx)
+            stmt.close
+         end
+         rows = cxn.execute_immediate('select COL10 from types_table where COL01 = 90')
+         assert_equal(21474836.47, rows.fetch[0])
+         rows.close
+      ensure
+         cxn.close
+      end
+   end
+
+   def test08
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         cxn.start_transaction do |tx|
+            stmt = cxn.create_statement("insert into types_table (COL01) values (?)")
+            assert_raise(RangeError) {stmt.exec([3_000_000_000], tx)}
+            assert_raise(RangeError) {stmt.exec([-2_147_483_649], tx)}
+            stmt.exec([2_147_483_647], tx)
+            stmt.close
+         end
+         rows = cxn.execute_immediate('select max(COL01) from types_table')
+         assert_equal(2_147_483_647, rows.fetch[0])
+         rows.close
+      ensure
+         cxn.close
+      end
+   end
+
+   def test09
+      cxn = @db.connect(DB_USER_NAME, DB_PASSWORD)
+      begin
+         sql = 'select COL03 from types_table order by COL01'
+         stmt = cxn.create_statement(sql)
+         $FireRubySettings[:DECIMAL_MODE] = :integer
+         rows = stmt.exec
+         # The mode is fixed when the statement is executed.
+         $FireRubySettings[:DECIMAL_MODE] = :float
+         assert_equal(237865, rows.fetch[0])
+         rows.close
+         stmt.close
+
+         $FireRubySettings[:DECIMAL_MODE] = :unknown
+         assert_raise(ArgumentError) {cxn.execute_immediate(sql)}
+      ensure
+         $FireRubySettings[:DECIMAL_MODE] = :float
+         cxn.close
+      end
+   end
 end